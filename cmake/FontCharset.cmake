@@ -0,0 +1,76 @@
+# Collect the characters the firmware can print into a header for the
+# compile time font subset, see FontTools::subsetFont.
+#
+# Run as a script:
+#   cmake -DSOURCES=<file;file> -DEXTRA=<characters> -DOUTPUT=<header> -P FontCharset.cmake
+#
+# Every character of every string and character literal in SOURCES is kept,
+# plus the digits and signs numbers are printed with and the characters in
+# EXTRA. Print::printNumber builds digits past 9 as 'A' + n, so the HEX
+# digits A-F are always kept, bases above 16 need their letters in EXTRA.
+# Comments are skipped. printf format strings add a few characters that are
+# never drawn, the set errs on the side of too many.
+
+set(charset " 0123456789ABCDEF+-.${EXTRA}")
+
+# Append the characters of one literal body, escapes resolved, controls dropped
+function(add_literal body)
+	string(REGEX REPLACE "\\\\[abfnrtv0]" "" body "${body}")
+	string(REGEX REPLACE "\\\\x[0-9A-Fa-f]+" "" body "${body}")
+	string(REGEX REPLACE "\\\\(.)" "\\1" body "${body}")
+	set(result "${charset}${body}")
+	set(charset "${result}" PARENT_SCOPE)
+endfunction()
+
+foreach(source IN LISTS SOURCES)
+	file(READ "${source}" text)
+	while(NOT text STREQUAL "")
+		string(REGEX MATCH "[\"'/]" token "${text}")
+		if(token STREQUAL "")
+			break()
+		endif()
+		string(FIND "${text}" "${token}" start)
+		string(SUBSTRING "${text}" ${start} -1 text)
+		if(text MATCHES "^//[^\n]*(.*)$")
+			set(text "${CMAKE_MATCH_1}")
+		elseif(text MATCHES "^/\\*")
+			string(FIND "${text}" "*/" end)
+			if(end EQUAL -1)
+				break()
+			endif()
+			math(EXPR end "${end} + 2")
+			string(SUBSTRING "${text}" ${end} -1 text)
+		elseif(text MATCHES "^\"(([^\"\\\\\n]|\\\\.)*)\"")
+			add_literal("${CMAKE_MATCH_1}")
+			string(LENGTH "${CMAKE_MATCH_0}" length)
+			string(SUBSTRING "${text}" ${length} -1 text)
+		elseif(text MATCHES "^'(([^'\\\\\n]|\\\\.)*)'")
+			add_literal("${CMAKE_MATCH_1}")
+			string(LENGTH "${CMAKE_MATCH_0}" length)
+			string(SUBSTRING "${text}" ${length} -1 text)
+		else()
+			string(SUBSTRING "${text}" 1 -1 text)
+		endif()
+	endwhile()
+endforeach()
+
+# Printable ASCII in code order, escaped for a C++ string literal
+set(literal "")
+foreach(code RANGE 32 126)
+	string(ASCII ${code} char)
+	string(FIND "${charset}" "${char}" found)
+	if(NOT found EQUAL -1)
+		if(char STREQUAL "\"" OR char STREQUAL "\\")
+			string(APPEND literal "\\")
+		endif()
+		string(APPEND literal "${char}")
+	endif()
+endforeach()
+
+set(header "// Generated by cmake/FontCharset.cmake, do not edit\n\n#pragma once\n\n#include <string_view>\n\n/*! @brief Characters kept by the default font subset */\ninline constexpr std::string_view FontCharset = \"${literal}\";\n")
+if(EXISTS "${OUTPUT}")
+	file(READ "${OUTPUT}" current)
+endif()
+if(NOT current STREQUAL header)
+	file(WRITE "${OUTPUT}" "${header}")
+endif()
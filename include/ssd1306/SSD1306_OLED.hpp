@@ -32,12 +32,20 @@ class SSD1306 : public SSD1306_graphics  {
 	
 	DisplayRet::Ret_Codes_e OLEDSetBufferPtr(uint8_t width, uint8_t height , std::span<uint8_t> buffer);
 	virtual void drawPixel(int16_t x, int16_t y, uint8_t color) override;
+	virtual void drawColumnByte(int16_t x, int16_t y, uint8_t data, bool invert) override;
 	DisplayRet::Ret_Codes_e OLEDupdate(void);
+	DisplayRet::Ret_Codes_e OLEDupdateRegion(int16_t x, int16_t y, int16_t w, int16_t h);
 	DisplayRet::Ret_Codes_e OLEDclearBuffer(void);
+	template <class Fn> DisplayRet::Ret_Codes_e OLEDupdateStrips(std::span<uint8_t> strip, Fn draw);
+	DisplayRet::Ret_Codes_e OLEDsaveBackground(std::span<uint8_t> layer);
+	DisplayRet::Ret_Codes_e OLEDrestoreBackground(std::span<const uint8_t> layer);
+	DisplayRet::Ret_Codes_e OLEDscrollRegionLeft(int16_t x, int16_t y, int16_t w, int16_t h, int16_t columns);
+	DisplayRet::Ret_Codes_e OLEDrestoreRegion(std::span<const uint8_t> layer, int16_t x, int16_t y, int16_t w, int16_t h);
 	void OLEDBuffer(int16_t x, int16_t y, uint8_t w, uint8_t h, std::span<uint8_t> data);
 	void OLEDFillScreen(uint8_t pixel, uint8_t mircodelay);
 	void OLEDFillPage(uint8_t page_num, uint8_t pixels,uint8_t delay);
 	DisplayRet::Ret_Codes_e OLEDBitmap(int16_t x, int16_t y, int16_t w, int16_t h, std::span<const uint8_t> bitmap, bool invert);
+	DisplayRet::Ret_Codes_e OLEDBitmapVertical(int16_t x, int16_t y, int16_t w, int16_t h, std::span<const uint8_t> bitmap, bool invert);
 	DisplayRet::Ret_Codes_e OLEDbegin(uint8_t I2c_address= SSD1306_ADDR , i2c_inst_t* i2c_type = i2c1 , uint16_t CLKspeed = 100, uint8_t SDApin = 18, uint8_t SCLKpin = 19);
 	void OLEDinit();
 	void OLEDdeI2CInit(void);
@@ -74,6 +82,13 @@ class SSD1306 : public SSD1306_graphics  {
   private:
 	
 	void I2CWriteByte(uint8_t value = 0x00, uint8_t DataOrCmd =  SSD1306_COMMAND);
+	void I2CWriteData(const uint8_t* data, uint8_t length);
+	ClipRect bufferRegion(int16_t x, int16_t y, int16_t w, int16_t h);
+	DisplayRet::Ret_Codes_e beginStrip(std::span<uint8_t> strip, uint8_t page);
+	void sendStrip(uint8_t page);
+	void endStrips(void);
+	void writeColumnBits(int16_t x, int16_t y, uint8_t data, uint8_t mask);
+	static void transposeBlock(const uint8_t rows[8], uint8_t cols[8]);
   //  === SSD1306 Command Set  ===
 	// Fundamental Commands
 	static constexpr uint8_t SSD1306_SET_CONTRAST_CONTROL = 0x81;
@@ -120,6 +135,7 @@ class SSD1306 : public SSD1306_graphics  {
 	static constexpr uint8_t SSD1306_COMMAND        = 0x00;
 	static constexpr uint8_t SSD1306_DATA           = 0xC0;
 	static constexpr uint8_t SSD1306_DATA_CONTINUE  = 0x40;
+	static constexpr uint8_t SSD1306_DATA_BURST_MAX = 128; /**< data bytes sent in one I2C transaction */
 	//  === SSD1306 Command Set END ===
 	
 	// I2C
@@ -141,7 +157,34 @@ class SSD1306 : public SSD1306_graphics  {
 	uint8_t _OLED_HEIGHT=64;    /**< Height of OLED Screen in pixels */
 	uint8_t _OLED_PAGE_NUM=(_OLED_HEIGHT/8); /**< Number of byte size pages OLED screen is divided into */
 	std::span<uint8_t> _OLEDbuffer; /**< Buffer to hold screen data */
+	SSD1306_PageBuffer _page; /**< Raster target over _OLEDbuffer, or the strip in strip mode */
 
 	const uint16_t _OLEDLibVerNum = 110; /**< Library version number 102 = 1.0.2*/
 
 }; 
+
+/*!
+	@brief Render and send the screen one page strip at a time, no full buffer needed
+	@param strip strip buffer, at least screen width bytes
+	@param draw callable drawing the whole screen, called once per page
+	@return Success or BufferSize
+	@details For each page the strip is cleared, the drawable area is cut to
+		the page's rows and draw() runs, so only pixels on that page reach the
+		strip. The strip is sent before the next page is drawn. Output matches
+		drawing once into a full buffer and calling OLEDupdate. draw() must
+		not depend on pixels drawn by an earlier call or change the rotation.
+		The full buffer, if one is set, is left untouched.
+*/
+template <class Fn>
+DisplayRet::Ret_Codes_e SSD1306::OLEDupdateStrips(std::span<uint8_t> strip, Fn draw)
+{
+	for (uint8_t page = 0; page < _OLED_PAGE_NUM; page++)
+	{
+		DisplayRet::Ret_Codes_e ret = beginStrip(strip, page);
+		if (ret != DisplayRet::Success) return ret;
+		draw();
+		sendStrip(page);
+	}
+	endStrips();
+	return DisplayRet::Success;
+}
@@ -11,7 +11,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <cmath>
-#include <string>
+#include <string_view>
 #include <array>
 #include "SSD1306_OLED_data.hpp"
 
@@ -73,7 +73,7 @@ class Print
 		size_t print(long, int = DEC);
 		size_t print(unsigned long, int = DEC);
 		size_t print(double, int = 2);
-		size_t print(const std::string &);
+		size_t print(std::string_view);
 
 		size_t println(const char[]);
 		size_t println(char);
@@ -83,5 +83,5 @@ class Print
 		size_t println(unsigned long, int = DEC);
 		size_t println(double, int = 2);
 		size_t println(void);
-		size_t println(const std::string &s);
+		size_t println(std::string_view s);
 };
@@ -0,0 +1,57 @@
+/*!
+	@file SSD1306_OLED_console.hpp
+	@brief OLED driven by SSD1306 controller. Character cell text console.
+	@details A 21 x 8 grid of 6x8 cells in the default font, one text row per
+		page. Writing a cell only marks it dirty when its character or
+		attribute changes. render() draws the dirty cells into the buffer and
+		flush() sends each run of dirty cells in a row as one page span, six
+		bytes per cell.
+*/
+
+#pragma once
+
+#include <array>
+#include "SSD1306_OLED.hpp"
+
+/*! @brief Character cell console drawn on a SSD1306 display */
+class SSD1306_Console
+{
+  public:
+	static constexpr uint8_t Columns = 21;   /**< cells per row, 126 of 128 pixels */
+	static constexpr uint8_t Rows = 8;       /**< rows, one per page */
+	static constexpr uint8_t CellWidth = 6;  /**< cell width in pixels, default font advance */
+	static constexpr uint8_t CellHeight = 8; /**< cell height in pixels, one page */
+
+	/*! Cell attribute bits */
+	enum CellAttr_e : uint8_t
+	{
+		AttrNone = 0x00,  /**< white text on black */
+		AttrInvert = 0x01 /**< black text on white */
+	};
+
+	explicit SSD1306_Console(SSD1306& display);
+
+	void clear(void);
+	void invalidate(void);
+	void setCell(uint8_t column, uint8_t row, char value, uint8_t attr = AttrNone);
+	uint8_t printAt(uint8_t column, uint8_t row, const char* text, uint8_t attr = AttrNone);
+	void printLine(uint8_t row, const char* text, uint8_t attr = AttrNone);
+	char getChar(uint8_t column, uint8_t row) const;
+	bool isDirty(uint8_t column, uint8_t row) const;
+
+	uint8_t render(void);
+	void flush(void);
+
+  private:
+	/*! @brief One character cell */
+	struct Cell_t
+	{
+		char value = ' ';        /**< character shown */
+		uint8_t attr = AttrNone; /**< CellAttr_e bits */
+	};
+
+	SSD1306& _display;                                /**< display drawn and flushed */
+	std::array<std::array<Cell_t, Columns>, Rows> _cells{}; /**< cell contents */
+	std::array<uint32_t, Rows> _dirty{};              /**< cells changed since render, bit n is column n */
+	std::array<uint32_t, Rows> _unsent{};             /**< cells rendered since flush */
+};
@@ -29,6 +29,12 @@ enum Ret_Codes_e : uint8_t
 	BufferEmpty = 14,           /**< The Buffer data container is an empty object*/
 	I2CbeginFail = 15,          /**< Failed to open I2C*/
 	I2CNotConnected = 16,       /**< I2C not connected as per checkConnection() tests */
-	GenericError = 17           /**< Generic Error message */
+	GenericError = 17,          /**< Generic Error message */
+	FontFormatInvalid = 18,     /**< Font header format is unknown or its glyph index is truncated */
+	WidgetPoolFull = 19,        /**< Display list has no free widget slot */
+	WidgetInvalid = 20,         /**< Widget id is not in use or is the wrong widget type */
+	RegionUnaligned = 21,       /**< Region must be page aligned, at rotation 0, inside the screen */
+	FontHeightUnaligned = 22,   /**< Raw font height is not a multiple of 8, page align it with FontTools::pageAlignFont or setFont(font, scratch) */
+	FontScratchTooSmall = 23    /**< Scratch buffer is smaller than the page aligned font, see FontTools::pageAlignedFontSize */
 };
 }
\ No newline at end of file
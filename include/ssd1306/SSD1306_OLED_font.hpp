@@ -13,6 +13,8 @@
 		-#  8. pFontArialRound 16 by 24
 		-#  9. pFontSevenSegNum 32 by 50
 		-#  10. pFontSixteenSeg 32 by 48 (NUMBERS ONLY + : . -)
+		-#  11. pFontSixteenSegRLE pFontSixteenSeg run length encoded
+		-#  12. pFontSixteenSegProp pFontSixteenSeg proportional and run length encoded
 */
 
 #pragma once
@@ -26,6 +28,8 @@
 extern const std::span<const uint8_t> pFontDefault;
 extern const std::span<const uint8_t> pFontWide;
 extern const std::span<const uint8_t> pFontSixteenSeg;
+extern const std::span<const uint8_t> pFontSixteenSegRLE;
+extern const std::span<const uint8_t> pFontSixteenSegProp;
 
 /*! @brief Font class to hold font data object  */
 class SSD1306_OLEDFonts 
@@ -35,7 +39,16 @@ class SSD1306_OLEDFonts
 		SSD1306_OLEDFonts();
 		~SSD1306_OLEDFonts() = default;
 
+		/*! Font format flags, byte 1 of the extended font header, see SSD1306_OLED_font_tools.hpp */
+		enum FontFormat_e : uint8_t {
+			FontFormatRaw = 0x00, /**< Legacy 4 byte header, fixed size glyphs stored back to back */
+			FontFormatRLE = 0x01, /**< Glyphs are run length encoded and found via an offset index */
+			FontFormatProportional = 0x02, /**< Per glyph advance, width and offset table, x_size is the widest glyph */
+			FontFormatSparse = 0x04 /**< Only some characters, a sorted character list maps them to glyphs */
+		};
+
 		DisplayRet::Ret_Codes_e setFont(std::span<const uint8_t> font);
+		DisplayRet::Ret_Codes_e setFont(std::span<const uint8_t> font, std::span<uint8_t> scratch);
 		void setInvertFont(bool invertStatus);
 		bool getInvertFont(void);
 
@@ -45,6 +58,15 @@ class SSD1306_OLEDFonts
 		uint8_t _Font_Y_Size = 0x08; /**< Height Size of a Font character */
 		uint8_t _FontOffset = 0x00; /**< Offset in the ASCII table 0x00 to 0xFF, where font begins */
 		uint8_t _FontNumChars = 0xFE; /**< Number of characters in font 0x00 to 0xFE */
+		uint8_t _FontFormat = FontFormatRaw; /**< Format flags of the active font */
+		uint16_t _FontIndexStart = 0; /**< Index in _FontSelect of the glyph table, extended fonts */
+		uint16_t _FontDataStart = 4; /**< Index in _FontSelect of the first glyph byte */
+
+		int16_t glyphIndex(char value);
+		uint16_t glyphStart(uint8_t glyphIndex);
+		uint8_t glyphPages(void);
+		uint8_t glyphWidth(uint8_t glyphIndex);
+		uint8_t glyphAdvance(uint8_t glyphIndex);
 	private:
 		bool _FontInverted = false; /**< Is the font inverted , False = normal , true = inverted*/
 };
@@ -0,0 +1,488 @@
+/*!
+	@file SSD1306_OLED_font_tools.hpp
+	@brief OLED driven by SSD1306 controller. Compile time font converters.
+	@details The functions here are constexpr so a raw font array can be
+		converted while compiling, only the converted table ends up in flash.
+		Extended font layout:
+		-# byte 0 : 0x00 marker (a raw font can never be zero width)
+		-# byte 1 : format flags, see SSD1306_OLEDFonts::FontFormat_e
+		-# byte 2-5 : x_size, y_size, offset, total characters (as raw header),
+			x_size is the widest glyph of a proportional font, a sparse font
+			holds its first character and glyph count - 1 in bytes 4-5
+		-# sparse fonts only: the character of each glyph, one byte each,
+			ascending, looked up with a binary search
+		-# RLE and proportional fonts only: one glyph table entry per glyph,
+			16 bit little endian offset into the glyph stream, proportional
+			fonts prefix it with the glyph advance and width bytes so every
+			lookup is a single table index. Fixed size glyphs need no table.
+		-# then the glyph stream, glyph width * pages bytes per glyph in the
+			same page order as a raw byte height font, stored as runs if RLE is
+			set. pages is y_size/8 rounded up, rows below y_size in the last
+			page are padding and never drawn.
+		A raw font whose height is not a multiple of 8 stores each glyph as a
+		continuous bit stream instead, MSB first, column by column. The
+		converters read both raw layouts, pageAlignFont turns the bit stream
+		into page columns so every font is drawn with the column byte blitter.
+		Run control byte: bits 7-6 tag, bits 5-0 run length - 1.
+		-# tag 0 : run of 0x00 bytes, no data follows
+		-# tag 1 : one data byte follows, repeated run length times
+		-# tag 2 : run length literal data bytes follow
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+#include <string_view>
+#include "SSD1306_OLED_font.hpp"
+
+namespace FontTools {
+
+static constexpr size_t RawHeaderSize = 4; /**< x_size, y_size, offset, total characters */
+static constexpr size_t ExtHeaderSize = 6; /**< marker, flags, then the raw header */
+
+static constexpr uint8_t RunZero = 0x00;    /**< RLE tag, run of zero bytes */
+static constexpr uint8_t RunRepeat = 0x40;  /**< RLE tag, repeated byte */
+static constexpr uint8_t RunLiteral = 0x80; /**< RLE tag, literal bytes */
+static constexpr uint8_t RunTagMask = 0xC0; /**< RLE control byte tag bits */
+static constexpr uint8_t RunMaxLength = 64; /**< longest run one control byte describes */
+
+/*!
+	@brief Size of one glyph table entry of an extended font
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the font
+	@return bytes per glyph, 0 when glyphs are fixed size and found by multiplication
+*/
+constexpr size_t glyphEntrySize(uint8_t flags)
+{
+	if (flags & SSD1306_OLEDFonts::FontFormatProportional) return 4;
+	if (flags & SSD1306_OLEDFonts::FontFormatRLE) return 2;
+	return 0;
+}
+
+/*!
+	@brief Number of pages (8 pixel row bands) a glyph of a raw font covers
+	@param raw raw font table
+*/
+constexpr size_t rawPages(std::span<const uint8_t> raw)
+{
+	return (raw[1] + 7) / 8;
+}
+
+/*!
+	@brief Number of data bytes per glyph of a raw font
+	@param raw raw font table
+*/
+constexpr size_t rawGlyphSize(std::span<const uint8_t> raw)
+{
+	if (raw[1] % 8 == 0)
+		return raw[0] * (raw[1] / 8);
+	return (raw[0] * raw[1]) / 8;
+}
+
+/*!
+	@brief Number of glyphs held by a raw font
+	@param raw raw font table
+	@return glyphs the header declares, fewer if the data ends early
+*/
+constexpr size_t rawGlyphCount(std::span<const uint8_t> raw)
+{
+	const size_t stored = (raw.size() - RawHeaderSize) / rawGlyphSize(raw);
+	return (stored < raw[3] + 1u) ? stored : raw[3] + 1u;
+}
+
+/*!
+	@brief One page column byte of a raw glyph, bit 0 is the top pixel
+	@param raw raw font table
+	@param glyph glyph number
+	@param col glyph column
+	@param page glyph page, rows past the font height read as clear
+*/
+constexpr uint8_t rawColumnByte(std::span<const uint8_t> raw, size_t glyph, size_t col, size_t page)
+{
+	const size_t width = raw[0];
+	const size_t height = raw[1];
+	const size_t start = RawHeaderSize + (glyph * rawGlyphSize(raw));
+	if (height % 8 == 0)
+		return raw[start + (page * width) + col];
+
+	uint8_t data = 0x00;
+	for (size_t bit = 0; bit < 8 && (page * 8) + bit < height; bit++)
+	{
+		const size_t pos = (col * height) + (page * 8) + bit;
+		const size_t index = start + (pos / 8);
+		if (index < raw.size() && (raw[index] & (0x80 >> (pos % 8))))
+			data |= (1 << bit);
+	}
+	return data;
+}
+
+/*!
+	@brief Encode one glyph into runs
+	@param in glyph data
+	@param len number of bytes in glyph data
+	@param out destination, nullptr to only measure
+	@return number of encoded bytes
+*/
+constexpr size_t rleEncodeGlyph(const uint8_t* in, size_t len, uint8_t* out)
+{
+	size_t outLen = 0;
+	size_t pos = 0;
+	while (pos < len)
+	{
+		size_t run = 1;
+		while (pos + run < len && run < RunMaxLength && in[pos + run] == in[pos]) run++;
+
+		if (in[pos] == 0x00)
+		{
+			if (out) out[outLen] = RunZero | (run - 1);
+			outLen += 1;
+		} else if (run >= 3)
+		{
+			if (out) {
+				out[outLen] = RunRepeat | (run - 1);
+				out[outLen + 1] = in[pos];
+			}
+			outLen += 2;
+		} else
+		{
+			// gather literals until a zero or a worthwhile repeat starts
+			run = 0;
+			while (pos + run < len && run < RunMaxLength && in[pos + run] != 0x00)
+			{
+				if (pos + run + 2 < len && in[pos + run] == in[pos + run + 1]
+					&& in[pos + run] == in[pos + run + 2]) break;
+				run++;
+			}
+			if (run == 0) run = 1;
+			if (out) {
+				out[outLen] = RunLiteral | (run - 1);
+				for (size_t i = 0; i < run; i++) out[outLen + 1 + i] = in[pos + i];
+			}
+			outLen += 1 + run;
+		}
+		pos += run;
+	}
+	return outLen;
+}
+
+static constexpr size_t MaxGlyphBytes = 2048; /**< largest glyph the RLE converter handles */
+
+/*!
+	@brief Find the first and last non blank column of a raw glyph
+	@param raw raw font table
+	@param glyph glyph number
+	@param first set to the first inked column
+	@param last set to the last inked column
+	@return false if the glyph is blank
+*/
+constexpr bool glyphInkColumns(std::span<const uint8_t> raw, size_t glyph, size_t& first, size_t& last)
+{
+	const size_t width = raw[0];
+	const size_t pages = rawPages(raw);
+	bool inked = false;
+	for (size_t col = 0; col < width; col++)
+	{
+		for (size_t page = 0; page < pages; page++)
+		{
+			if (rawColumnByte(raw, glyph, col, page) != 0x00)
+			{
+				if (!inked) first = col;
+				last = col;
+				inked = true;
+				break;
+			}
+		}
+	}
+	return inked;
+}
+
+/*!
+	@brief Copy a raw glyph in the page layout a converted font stores it
+	@param raw raw font table
+	@param glyph glyph number
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param out destination, nullptr to only measure
+	@param width set to the number of columns stored
+	@param advance set to the cursor advance in pixels
+	@return number of bytes stored in out
+*/
+constexpr size_t convertGlyph(std::span<const uint8_t> raw, size_t glyph, uint8_t flags,
+	uint8_t spacing, uint8_t* out, uint8_t& width, uint8_t& advance)
+{
+	const size_t rawWidth = raw[0];
+	const size_t pages = rawPages(raw);
+	size_t first = 0;
+	size_t last = rawWidth - 1;
+	width = rawWidth;
+	advance = rawWidth;
+	if (flags & SSD1306_OLEDFonts::FontFormatProportional)
+	{
+		if (glyphInkColumns(raw, glyph, first, last))
+		{
+			width = last - first + 1;
+			advance = width + spacing;
+		} else
+		{
+			width = 0; // blank glyph such as space, advance only
+			advance = (rawWidth / 2) + spacing;
+		}
+	}
+	if (out)
+	{
+		for (size_t page = 0; page < pages; page++)
+			for (size_t col = 0; col < width; col++)
+				out[(page * width) + col] = rawColumnByte(raw, glyph, first + col, page);
+	}
+	return width * pages;
+}
+
+/*!
+	@brief Copy a raw glyph into a buffer, then encode it into runs
+	@param raw raw font table
+	@param glyph glyph number
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param out destination, nullptr to only measure
+	@param width set to the number of columns stored
+	@param advance set to the cursor advance in pixels
+	@return number of encoded bytes
+*/
+constexpr size_t rleConvertGlyph(std::span<const uint8_t> raw, size_t glyph, uint8_t flags,
+	uint8_t spacing, uint8_t* out, uint8_t& width, uint8_t& advance)
+{
+	std::array<uint8_t, MaxGlyphBytes> buffer{};
+	const size_t len = convertGlyph(raw, glyph, flags, spacing, buffer.data(), width, advance);
+	return rleEncodeGlyph(buffer.data(), len, out);
+}
+
+/*!
+	@brief Copy a raw glyph as a converted font stores it
+	@param raw raw font table
+	@param glyph glyph number
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param out destination, nullptr to only measure
+	@param width set to the number of columns stored
+	@param advance set to the cursor advance in pixels
+	@return number of bytes stored in out
+	@note The glyph buffer only lives in rleConvertGlyph, the plain layout
+		is written straight to out so a run time conversion needs little stack.
+*/
+constexpr size_t encodeGlyph(std::span<const uint8_t> raw, size_t glyph, uint8_t flags,
+	uint8_t spacing, uint8_t* out, uint8_t& width, uint8_t& advance)
+{
+	if (flags & SSD1306_OLEDFonts::FontFormatRLE)
+		return rleConvertGlyph(raw, glyph, flags, spacing, out, width, advance);
+	return convertGlyph(raw, glyph, flags, spacing, out, width, advance);
+}
+
+/*!
+	@brief true if a raw glyph goes into the converted font
+	@param raw raw font table
+	@param glyph glyph number
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param charset characters kept by a sparse font, any order, repeats allowed
+*/
+constexpr bool glyphSelected(std::span<const uint8_t> raw, size_t glyph, uint8_t flags, std::string_view charset)
+{
+	if (!(flags & SSD1306_OLEDFonts::FontFormatSparse)) return true;
+	const char value = static_cast<char>(raw[2] + glyph);
+	for (char c : charset)
+		if (c == value) return true;
+	return false;
+}
+
+/*!
+	@brief Number of glyphs in the converted font
+	@param raw raw font table
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param charset characters kept by a sparse font
+*/
+constexpr size_t selectedGlyphCount(std::span<const uint8_t> raw, uint8_t flags, std::string_view charset)
+{
+	size_t count = 0;
+	for (size_t g = 0; g < rawGlyphCount(raw); g++)
+		if (glyphSelected(raw, g, flags, charset)) count++;
+	return count;
+}
+
+/*!
+	@brief Size in bytes of a raw font converted to another format, use as
+		template argument of convertFont
+	@param raw raw font table
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param charset characters kept if flags has FontFormatSparse
+*/
+constexpr size_t convertedFontSize(std::span<const uint8_t> raw, uint8_t flags, uint8_t spacing = 1,
+	std::string_view charset = {})
+{
+	const size_t glyphs = selectedGlyphCount(raw, flags, charset);
+	const size_t chars = (flags & SSD1306_OLEDFonts::FontFormatSparse) ? glyphs : 0;
+	size_t size = ExtHeaderSize + chars + (glyphEntrySize(flags) * glyphs);
+	for (size_t g = 0; g < rawGlyphCount(raw); g++)
+	{
+		if (!glyphSelected(raw, g, flags, charset)) continue;
+		uint8_t width = 0, advance = 0;
+		size += encodeGlyph(raw, g, flags, spacing, nullptr, width, advance);
+	}
+	return size;
+}
+
+/*!
+	@brief Write a raw font converted to the extended font format
+	@details Proportional glyph metrics entry: advance, width, data offset low, data offset high.
+	@param raw raw font table
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param font destination, convertedFontSize bytes long
+	@param charset characters kept if flags has FontFormatSparse, at least
+		one of them must be in the raw font
+	@return number of bytes written
+*/
+constexpr size_t writeFont(std::span<const uint8_t> raw, uint8_t flags, uint8_t spacing, uint8_t* font,
+	std::string_view charset = {})
+{
+	const size_t glyphs = selectedGlyphCount(raw, flags, charset);
+	const bool sparse = flags & SSD1306_OLEDFonts::FontFormatSparse;
+	const size_t entry = glyphEntrySize(flags);
+	const size_t indexStart = ExtHeaderSize + (sparse ? glyphs : 0);
+
+	font[0] = 0x00;
+	font[1] = flags;
+	font[2] = raw[0];
+	font[3] = raw[1];
+	font[4] = raw[2];
+	font[5] = glyphs - 1;  // glyphs stored, a raw header may declare more than its data holds
+
+	size_t stream = 0;
+	size_t n = 0;
+	const size_t streamStart = indexStart + (entry * glyphs);
+	for (size_t g = 0; g < rawGlyphCount(raw); g++)
+	{
+		if (!glyphSelected(raw, g, flags, charset)) continue;
+		if (sparse)
+		{
+			if (n == 0) font[4] = raw[2] + g;
+			font[ExtHeaderSize + n] = raw[2] + g;
+		}
+		size_t pos = indexStart + (entry * n);
+		uint8_t width = 0, advance = 0;
+		const size_t len = encodeGlyph(raw, g, flags, spacing, font + streamStart + stream, width, advance);
+		if (entry == 4)
+		{
+			font[pos++] = advance;
+			font[pos++] = width;
+		}
+		if (entry != 0)
+		{
+			font[pos++] = stream & 0xFF;
+			font[pos] = (stream >> 8) & 0xFF;
+		}
+		stream += len;
+		n++;
+	}
+	return streamStart + stream;
+}
+
+/*!
+	@brief Convert a raw font to the extended font format
+	@tparam M size of the result, from convertedFontSize
+	@param raw raw font table
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags of the converted font
+	@param spacing blank columns appended after a proportional glyph
+	@param charset characters kept if flags has FontFormatSparse
+	@return font table that can be passed to setFont
+*/
+template <size_t M>
+constexpr std::array<uint8_t, M> convertFont(std::span<const uint8_t> raw, uint8_t flags, uint8_t spacing = 1,
+	std::string_view charset = {})
+{
+	static_assert(M > ExtHeaderSize, "Converted font size too small, use convertedFontSize");
+	std::array<uint8_t, M> font{};
+	writeFont(raw, flags, spacing, font.data(), charset);
+	return font;
+}
+
+/*!
+	@brief Size in bytes of the RLE version of a raw font, use as template
+		argument of rleEncodeFont
+	@param raw raw font table
+*/
+constexpr size_t rleFontSize(std::span<const uint8_t> raw)
+{
+	return convertedFontSize(raw, SSD1306_OLEDFonts::FontFormatRLE);
+}
+
+/*!
+	@brief Convert a raw font to the RLE font format
+	@tparam M size of the result, from rleFontSize
+	@param raw raw font table
+	@return font table that can be passed to setFont
+*/
+template <size_t M>
+constexpr std::array<uint8_t, M> rleEncodeFont(std::span<const uint8_t> raw)
+{
+	return convertFont<M>(raw, SSD1306_OLEDFonts::FontFormatRLE);
+}
+
+/*!
+	@brief Size in bytes of the page aligned version of a raw font, use as
+		template argument of pageAlignFont
+	@param raw raw font table
+*/
+constexpr size_t pageAlignedFontSize(std::span<const uint8_t> raw)
+{
+	return convertedFontSize(raw, SSD1306_OLEDFonts::FontFormatRaw);
+}
+
+/*!
+	@brief Convert a raw font to fixed width page columns, the last page padded
+	@tparam M size of the result, from pageAlignedFontSize
+	@param raw raw font table, any height
+	@return font table that can be passed to setFont
+	@note For fonts whose height is not a multiple of 8, which setFont only
+		takes in this layout. See SSD1306_OLEDFonts::setFont(font, scratch) to
+		convert at run time instead.
+*/
+template <size_t M>
+constexpr std::array<uint8_t, M> pageAlignFont(std::span<const uint8_t> raw)
+{
+	return convertFont<M>(raw, SSD1306_OLEDFonts::FontFormatRaw);
+}
+
+/*!
+	@brief Size in bytes of a subset of a raw font, use as template argument of subsetFont
+	@param raw raw font table
+	@param charset characters to keep
+	@param flags extra SSD1306_OLEDFonts::FontFormat_e flags, e.g. RLE
+	@param spacing blank columns appended after a proportional glyph
+*/
+constexpr size_t subsetFontSize(std::span<const uint8_t> raw, std::string_view charset,
+	uint8_t flags = SSD1306_OLEDFonts::FontFormatRaw, uint8_t spacing = 1)
+{
+	return convertedFontSize(raw, flags | SSD1306_OLEDFonts::FontFormatSparse, spacing, charset);
+}
+
+/*!
+	@brief Convert a raw font to a sparse font holding only some characters
+	@tparam M size of the result, from subsetFontSize
+	@param raw raw font table
+	@param charset characters to keep, any order, characters the raw font
+		lacks are skipped, at least one must be present
+	@param flags extra SSD1306_OLEDFonts::FontFormat_e flags, e.g. RLE
+	@param spacing blank columns appended after a proportional glyph
+	@return font table that can be passed to setFont, writeChar reports
+		CharFontASCIIRange for characters left out
+*/
+template <size_t M>
+constexpr std::array<uint8_t, M> subsetFont(std::span<const uint8_t> raw, std::string_view charset,
+	uint8_t flags = SSD1306_OLEDFonts::FontFormatRaw, uint8_t spacing = 1)
+{
+	return convertFont<M>(raw, flags | SSD1306_OLEDFonts::FontFormatSparse, spacing, charset);
+}
+
+} // namespace FontTools
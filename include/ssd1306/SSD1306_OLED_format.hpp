@@ -0,0 +1,138 @@
+/*!
+	@file SSD1306_OLED_format.hpp
+	@brief OLED driven by SSD1306 controller. Fixed point number formatting and a fixed capacity string.
+	@details Numbers with a fraction are held as scaled integers, e.g. 123.4
+		as 1234 with one decimal, and turned into text with integer division
+		by 10 only. The RP2040 has no FPU, this keeps soft float maths and the
+		float support of printf out of the text path, the divisions map to the
+		hardware divider. FixedString composes a line of text in place, e.g.
+		"D:25.00mm SFM:", without heap use, ready for a single drawText call.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <string_view>
+
+/*! @brief Integer only number to text conversion */
+namespace FixedFormat
+{
+	constexpr uint8_t MaxDecimals = 9;  /**< fraction digits a scaled 32 bit value can hold */
+	constexpr uint8_t MaxLength = 12;   /**< longest number written without padding, sign and point included */
+
+	/*! Placement of the number inside the field width */
+	enum Align_e : uint8_t
+	{
+		AlignLeft = 0,  /**< number first, space padding after it */
+		AlignRight = 1, /**< space padding first */
+		AlignZero = 2   /**< zero padding between the sign and the digits */
+	};
+
+	size_t formatFixed(char* buffer, size_t size, int32_t value, uint8_t width, uint8_t decimals,
+		Align_e align = AlignRight);
+	int32_t toFixed(float value, uint8_t decimals);
+}
+
+/*!
+	@brief Text of at most N characters built in place, never allocates
+	@tparam N capacity in characters, the terminator is extra
+	@details Appends past the capacity are cut off and set overflow(),
+		a number that does not fit is left out whole rather than cut.
+*/
+template <size_t N>
+class FixedString
+{
+  public:
+	static_assert(N > 0, "FixedString needs room for one character");
+
+	FixedString() = default;
+	/*! @brief init with a text, cut to the capacity */
+	explicit FixedString(std::string_view text) { append(text); }
+
+	/*! @brief Empty the text and the overflow flag */
+	FixedString& clear(void)
+	{
+		_length = 0;
+		_text[0] = '\0';
+		_overflow = false;
+		return *this;
+	}
+
+	/*! @brief Append one character */
+	FixedString& append(char value)
+	{
+		if (_length == N)
+		{
+			_overflow = true;
+			return *this;
+		}
+		_text[_length++] = value;
+		_text[_length] = '\0';
+		return *this;
+	}
+
+	/*! @brief Append a text, cut at the capacity */
+	FixedString& append(std::string_view text)
+	{
+		size_t count = text.size();
+		if (count > N - _length)
+		{
+			count = N - _length;
+			_overflow = true;
+		}
+		text.copy(_text.data() + _length, count);
+		_length += count;
+		_text[_length] = '\0';
+		return *this;
+	}
+
+	/*!
+		@brief Append a scaled integer, see FixedFormat::formatFixed
+		@param value number times 10 to the power of decimals
+		@param width minimum field width, 0 for none
+		@param decimals digits after the decimal point
+		@param align placement inside the field
+	*/
+	FixedString& appendNumber(int32_t value, uint8_t width = 0, uint8_t decimals = 0,
+		FixedFormat::Align_e align = FixedFormat::AlignRight)
+	{
+		const size_t count = FixedFormat::formatFixed(_text.data() + _length, N + 1 - _length,
+			value, width, decimals, align);
+		if (count == 0) _overflow = true;
+		_length += count;
+		return *this;
+	}
+
+	/*!
+		@brief Append a float rounded to a number of decimals, see FixedFormat::toFixed
+		@param value number
+		@param decimals digits after the decimal point
+		@param width minimum field width, 0 for none
+		@param align placement inside the field
+	*/
+	FixedString& appendFixed(float value, uint8_t decimals, uint8_t width = 0,
+		FixedFormat::Align_e align = FixedFormat::AlignRight)
+	{
+		return appendNumber(FixedFormat::toFixed(value, decimals), width, decimals, align);
+	}
+
+	/*! @brief zero terminated text */
+	inline const char* c_str() const { return _text.data(); }
+	/*! @brief text without the terminator */
+	inline std::string_view view() const { return std::string_view(_text.data(), _length); }
+	/*! @brief text without the terminator, e.g. for drawText */
+	inline operator std::string_view() const { return view(); }
+	/*! @brief characters held */
+	inline size_t length() const { return _length; }
+	/*! @brief characters that fit */
+	static constexpr size_t capacity() { return N; }
+	/*! @brief true if something was cut off or left out since the last clear */
+	inline bool overflow() const { return _overflow; }
+
+  private:
+	std::array<char, N + 1> _text{}; /**< characters and the terminator */
+	size_t _length = 0;              /**< characters held */
+	bool _overflow = false;          /**< an append did not fit */
+};
@@ -10,8 +10,10 @@
 #pragma once
 
 #include <cmath> // for "abs"
+#include <string_view>
 #include "SSD1306_OLED_font.hpp"
 #include "SSD1306_OLED_Print.hpp"
+#include "SSD1306_OLED_pagebuffer.hpp"
 
 
 
@@ -32,7 +34,16 @@ class SSD1306_graphics : public SSD1306_OLEDFonts , public Print
 		rDegrees_270 = 3     /**< display screen rotated 270 degrees */
 	};
 
+	/*! Enum to hold text alignment against an anchor x co-ordinate */
+	enum text_align_e : uint8_t
+	{
+		alignLeft = 0,   /**< text starts at the anchor */
+		alignCenter = 1, /**< text is centred on the anchor */
+		alignRight = 2   /**< text ends at the anchor */
+	};
+
 	virtual void drawPixel(int16_t x, int16_t y, uint8_t color) = 0;
+	virtual void drawColumnByte(int16_t x, int16_t y, uint8_t data, bool invert);
 	// Graphics functions
 	void drawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color);
 	void drawFastVLine(int16_t x, int16_t y, int16_t h, uint8_t color);
@@ -57,17 +68,30 @@ class SSD1306_graphics : public SSD1306_OLEDFonts , public Print
 	  int16_t radius, uint8_t color);
 	void setCursor(int16_t x, int16_t y);	
 
+	DisplayRet::Ret_Codes_e drawSegmentNumber(int16_t x, int16_t y, int16_t h, const char *text, uint8_t color);
+	int16_t measureSegmentNumber(int16_t h, const char *text);
+
 	// Text related functions 
 	virtual size_t write(uint8_t);
 	DisplayRet::Ret_Codes_e writeChar( int16_t x, int16_t y, char value );
 	DisplayRet::Ret_Codes_e writeCharString( int16_t x, int16_t y, char *text);
+	DisplayRet::Ret_Codes_e writeCharStringAligned(int16_t x, int16_t y, const char *text, text_align_e align);
+	DisplayRet::Ret_Codes_e drawText(int16_t x, int16_t y, std::string_view text, text_align_e align = alignLeft);
+	uint8_t measureChar(char value);
+	int16_t measureString(const char *text);
+	int16_t measureText(std::string_view text);
 	void setTextWrap(bool w);
+	void setTextScale(uint8_t scale);
+	uint8_t getTextScale(void) const;
 
 	int16_t height(void) const;
 	int16_t width(void) const;
 	display_rotate_e getRotation(void);
 	void setRotation(display_rotate_e r);
 
+	void setClipRect(int16_t x, int16_t y, int16_t w, int16_t h);
+	void resetClip(void);
+
  protected:
 	
 	const int16_t WIDTH;  /**< This is the 'raw' display w - never changes */
@@ -79,18 +103,17 @@ class SSD1306_graphics : public SSD1306_OLEDFonts , public Print
 	int16_t _cursor_y = 0;  /**< Current Y co-ord cursor position */
 	
 	bool _textwrap = true;  /**< If set, text at right edge of display will wrap, print method*/
+	uint8_t _textScale = 1; /**< Integer scale text is drawn at, 1-4 */
+
+	ClipRect _clip; /**< Clip rectangle in rotated co-ordinates, always inside _drawable */
+	ClipRect _drawable; /**< Area drawing may reach, the screen or the strip being rendered, rotated co-ordinates */
+	SSD1306_PageBuffer* _pageTarget = nullptr; /**< page buffer primitives render into directly at rotation 0, set by the sub-class */
 
 	private:
-	/*!
-		@brief Swaps the values of two int16_t variables.
-		@param a Reference to the first integer.
-		@param b Reference to the second integer.
-		@note This function swaps the values in place without using additional memory.
-	*/
-	inline void swapInt16_OLED(int16_t& a, int16_t& b) {
-		int16_t t = a;
-		a = b;
-		b = t;
-	}
+	template <class Fn> void render(Fn fn);
+	void drawGlyph(int16_t x, int16_t y, int16_t glyph);
+	void drawGlyphRLE(int16_t x, int16_t y, uint16_t fontIndex, uint8_t glyphCols, bool invert);
+	void drawGlyphByte(int16_t x, int16_t y, uint8_t col, uint8_t page, uint8_t data, bool invert);
+	void drawSegment(int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool vertical, uint8_t color);
 };
 
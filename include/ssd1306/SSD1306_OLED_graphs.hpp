@@ -0,0 +1,156 @@
+/*!
+	@file SSD1306_OLED_graphs.hpp
+	@brief OLED driven by SSD1306 controller. Incremental sparkline, bar graph and dial gauge.
+	@details All draw straight into the display buffer and only touch the
+		pixels that change. The sparkline scrolls its area left by one column
+		per time bucket and draws only the newest column. The bar graph fills
+		or clears only the span between the old and new bar ends. Send their
+		bounds() to the screen after an update returns true. The gauge face is
+		drawn once, e.g. into a background layer, and the needle is moved by
+		redrawing the old and new needle lines only, send its damage().
+*/
+
+#pragma once
+
+#include <array>
+#include "SSD1306_OLED.hpp"
+
+/*! @brief Fixed point sine and cosine, the table is built at compile time */
+namespace FixedTrig
+{
+	constexpr uint16_t AngleSteps = 1024;            /**< angle units per turn */
+	constexpr uint16_t QuarterSteps = AngleSteps / 4; /**< angle units per quarter turn */
+	constexpr int16_t One = 16384;                   /**< 1.0 in Q14 */
+
+	/*! @brief sin(i * 90 / QuarterSteps degrees) in Q14 for i = 0 to QuarterSteps, Taylor series */
+	consteval std::array<int16_t, QuarterSteps + 1> makeQuarterSine()
+	{
+		std::array<int16_t, QuarterSteps + 1> table{};
+		for (uint16_t i = 0; i <= QuarterSteps; i++)
+		{
+			const double x = (3.14159265358979323846 / 2.0) * i / QuarterSteps;
+			double term = x;
+			double sum = x;
+			for (int n = 1; n < 12; n++)
+			{
+				term *= -x * x / ((2 * n) * (2 * n + 1));
+				sum += term;
+			}
+			table[i] = static_cast<int16_t>(sum * One + 0.5);
+		}
+		return table;
+	}
+
+	inline constexpr std::array<int16_t, QuarterSteps + 1> QuarterSine = makeQuarterSine(); /**< first quarter of the sine wave */
+	static_assert(QuarterSine[0] == 0 && QuarterSine[QuarterSteps] == One, "sine table out of range");
+
+	/*! @brief sine of an angle in AngleSteps per turn, Q14 */
+	constexpr int16_t sine(uint16_t angle)
+	{
+		angle %= AngleSteps;
+		const uint16_t phase = angle % (2 * QuarterSteps);
+		const int16_t value = QuarterSine[(phase <= QuarterSteps) ? phase : 2 * QuarterSteps - phase];
+		return (angle < 2 * QuarterSteps) ? value : -value;
+	}
+
+	/*! @brief cosine of an angle in AngleSteps per turn, Q14 */
+	constexpr int16_t cosine(uint16_t angle)
+	{
+		return sine(static_cast<uint16_t>(angle + QuarterSteps));
+	}
+}
+
+/*! @brief Scrolling min/max sparkline */
+class SSD1306_Sparkline
+{
+  public:
+	static constexpr uint8_t MaxColumns = 128; /**< history columns kept */
+
+	SSD1306_Sparkline(SSD1306& display, int16_t x, int16_t y, int16_t w, int16_t h,
+		int16_t min, int16_t max, uint8_t samplesPerColumn = 1);
+
+	bool addSample(int16_t value);
+	void redraw(void);
+	void clear(void);
+	/*! @brief area drawn, x1 and y1 exclusive */
+	inline const ClipRect& bounds() const { return _bounds; }
+
+  private:
+	/*! @brief One time bucket, the range of the samples it holds */
+	struct Column_t
+	{
+		int16_t low;  /**< smallest sample */
+		int16_t high; /**< largest sample */
+	};
+
+	void drawColumn(int16_t x, const Column_t& column);
+	int16_t rowOf(int16_t value) const;
+
+	SSD1306& _display;       /**< display drawn on */
+	ClipRect _bounds;        /**< chart area, newest column on the right */
+	int16_t _min;            /**< value drawn on the bottom row */
+	int16_t _max;            /**< value drawn on the top row */
+	uint8_t _samplesPerColumn; /**< samples decimated into one column */
+	std::array<Column_t, MaxColumns> _history{}; /**< ring of finished columns */
+	uint8_t _head = 0;       /**< ring slot the next column goes in */
+	uint8_t _count = 0;      /**< finished columns held */
+	Column_t _bucket{};      /**< column being filled */
+	uint8_t _bucketSamples = 0; /**< samples in _bucket */
+};
+
+/*! @brief Horizontal bar graph inside a one pixel outline */
+class SSD1306_BarGraph
+{
+  public:
+	SSD1306_BarGraph(SSD1306& display, int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max);
+
+	bool setValue(int32_t value);
+	void redraw(void);
+	/*! @brief area drawn, x1 and y1 exclusive */
+	inline const ClipRect& bounds() const { return _bounds; }
+
+  private:
+	int16_t fillOf(int32_t value) const;
+
+	SSD1306& _display; /**< display drawn on */
+	ClipRect _bounds;  /**< outline area */
+	int32_t _min;      /**< value shown as an empty bar */
+	int32_t _max;      /**< value shown as a full bar */
+	int16_t _fill = 0; /**< filled columns drawn */
+};
+
+/*! @brief Analog dial gauge, a static face and a needle moved in place */
+class SSD1306_Gauge
+{
+  public:
+	static constexpr uint8_t HubRadius = 2;   /**< filled circle at the needle pivot */
+	static constexpr uint8_t MajorTick = 5;   /**< major tick length in pixels */
+	static constexpr uint8_t MinorTick = 2;   /**< minor tick length in pixels */
+
+	SSD1306_Gauge(SSD1306& display, int16_t cx, int16_t cy, int16_t radius, int16_t needle,
+		uint16_t startAngle, uint16_t sweep, int32_t min, int32_t max);
+
+	void drawFace(uint8_t divisions, uint8_t minorPerDivision);
+	void pointAt(int32_t value, int16_t radius, int16_t& x, int16_t& y) const;
+	bool setValue(int32_t value);
+	void redraw(void);
+	/*! @brief area changed by the last setValue that returned true, x1 and y1 exclusive */
+	inline const ClipRect& damage() const { return _damage; }
+
+  private:
+	uint16_t angleOf(int32_t value) const;
+	void pointAtAngle(uint16_t angle, int16_t radius, int16_t& x, int16_t& y) const;
+	ClipRect drawNeedle(uint16_t angle);
+
+	SSD1306& _display;    /**< display drawn on */
+	int16_t _cx;          /**< needle pivot x */
+	int16_t _cy;          /**< needle pivot y */
+	int16_t _radius;      /**< outer edge of the ticks */
+	int16_t _needle;      /**< needle tip distance from the pivot */
+	uint16_t _startAngle; /**< angle of min, FixedTrig units, 0 points right, clockwise */
+	uint16_t _sweep;      /**< angle from min to max */
+	int32_t _min;         /**< value at the start of the dial */
+	int32_t _max;         /**< value at the end of the dial */
+	uint16_t _angle;      /**< angle of the needle drawn */
+	ClipRect _damage{};   /**< old and new needle area of the last move */
+};
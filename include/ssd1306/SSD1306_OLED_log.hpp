@@ -0,0 +1,35 @@
+/*!
+	@file SSD1306_OLED_log.hpp
+	@brief OLED driven by SSD1306 controller. Deferred binary log.
+	@details log() stores a fixed size record, the format string pointer, a
+		microsecond timestamp and up to three integer arguments, in a ring and
+		returns. Nothing is formatted or sent at the call site, so it can be
+		used from drawing code, I2C retries and interrupt handlers alike. The
+		main loop calls drain() when idle, which resolves the format strings
+		with printf. When the ring is full new records are dropped and counted.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+/*! @brief Ring of log records written from any context, printed later */
+namespace DeferredLog
+{
+	constexpr uint32_t RingSize = 32; /**< records held, a power of two */
+	static_assert((RingSize & (RingSize - 1)) == 0, "log ring size must be a power of two");
+
+	/*! @brief One log call */
+	struct Record_t
+	{
+		const char* format; /**< printf format in flash, integer and %c conversions only */
+		uint32_t time;      /**< time_us_32 when logged */
+		int32_t args[3];    /**< format arguments */
+		volatile uint32_t sequence; /**< write index + 1 once the record is complete */
+	};
+
+	void log(const char* format, int32_t a = 0, int32_t b = 0, int32_t c = 0);
+	size_t drain(size_t maxRecords = RingSize);
+	uint32_t dropped(void);
+}
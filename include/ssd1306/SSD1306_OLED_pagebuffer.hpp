@@ -0,0 +1,139 @@
+/*!
+	@file SSD1306_OLED_pagebuffer.hpp
+	@brief OLED driven by SSD1306 controller. 1bpp page buffer raster target.
+	@details Byte n of page p holds column n, rows p*8 to p*8+7, bit 0 on top.
+		All methods are inline and non virtual so the templated algorithms in
+		SSD1306_OLED_raster.hpp compile down to direct buffer access. The same
+		class serves the screen buffer, an off-screen sprite, a host test
+		buffer or one page strip of the screen, it only needs a span of
+		width * (height/8) bytes.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+/*!
+	@brief Clip rectangle, x1 and y1 are exclusive
+*/
+struct ClipRect {
+	int16_t x0 = 0; /**< first column drawn */
+	int16_t y0 = 0; /**< first row drawn */
+	int16_t x1 = 0; /**< column after the last column drawn */
+	int16_t y1 = 0; /**< row after the last row drawn */
+
+	/*! @brief true if pixel (x,y) may be drawn */
+	inline bool contains(int16_t x, int16_t y) const {
+		return (x >= x0) && (x < x1) && (y >= y0) && (y < y1);
+	}
+
+	/*! @brief true if no pixel of the box at (x,y) size w by h may be drawn */
+	inline bool rejects(int16_t x, int16_t y, int16_t w, int16_t h) const {
+		return (x >= x1) || (y >= y1) || ((x + w) <= x0) || ((y + h) <= y0);
+	}
+};
+
+/*!
+	@brief Raster target for a 1bpp vertically addressed page buffer
+	@details Colors follow SSD1306::PixelColor, 0 black, 1 white, 2 inverse.
+		Co-ordinates passed in must already be inside the buffer.
+*/
+class SSD1306_PageBuffer {
+  public:
+	SSD1306_PageBuffer() = default;
+	/*!
+		@param buffer buffer data, width * (height/8) bytes
+		@param width width in pixels
+		@param height height in pixels, multiple of 8
+		@param top screen row held in bit 0 of the first page, multiple of 8,
+			non zero for a strip of a larger screen
+	*/
+	SSD1306_PageBuffer(std::span<uint8_t> buffer, int16_t width, int16_t height, int16_t top = 0)
+		: _buffer(buffer), _width(width), _height(height), _top(top) {}
+
+	/*! @brief rows held, in screen co-ordinates, as a clip rectangle */
+	inline ClipRect bounds() const { return ClipRect{0, _top, _width, static_cast<int16_t>(_top + _height)}; }
+	/*! @brief false until a buffer is assigned */
+	inline bool valid() const { return !_buffer.empty(); }
+	/*! @brief buffer width in pixels */
+	inline int16_t width() const { return _width; }
+	/*! @brief buffer height in pixels */
+	inline int16_t height() const { return _height; }
+	/*! @brief screen row of the first buffer row */
+	inline int16_t top() const { return _top; }
+	/*! @brief buffer data */
+	inline std::span<uint8_t> data() const { return _buffer; }
+
+	/*! @brief bytes of the page holding screen row y, y page aligned and inside the buffer */
+	inline uint8_t* pageRow(int16_t y) { return &_buffer[_width * ((y - _top) >> 3)]; }
+
+	/*! @brief set, clear or invert one pixel */
+	inline void plot(int16_t x, int16_t y, uint8_t color) {
+		y -= _top;
+		apply(_buffer[(_width * (y >> 3)) + x], 1 << (y & 7), color);
+	}
+
+	/*!
+		@brief Fill rows y0 to y1 of column x, y0 <= y1
+		@note Inner pages are written as whole bytes, the end pages with a mask.
+	*/
+	inline void vspan(int16_t x, int16_t y0, int16_t y1, uint8_t color) {
+		y0 -= _top;
+		y1 -= _top;
+		int16_t page = y0 >> 3;
+		const int16_t lastPage = y1 >> 3;
+		uint8_t* byte = &_buffer[(_width * page) + x];
+		uint8_t mask = 0xFF << (y0 & 7);
+		for (; page < lastPage; page++, byte += _width) {
+			apply(*byte, mask, color);
+			mask = 0xFF;
+		}
+		apply(*byte, mask & (0xFF >> (7 - (y1 & 7))), color);
+	}
+
+	/*! @brief Fill columns x0 to x1 of row y, x0 <= x1 */
+	inline void hspan(int16_t x0, int16_t x1, int16_t y, uint8_t color) {
+		y -= _top;
+		const uint8_t mask = 1 << (y & 7);
+		uint8_t* row = &_buffer[_width * (y >> 3)];
+		for (int16_t x = x0; x <= x1; x++)
+			apply(row[x], mask, color);
+	}
+
+	/*!
+		@brief Write the masked bits of an 8 pixel column
+		@param x column
+		@param y row of bit 0, may be negative or not page aligned
+		@param data column pixels, LSB on top
+		@param mask bits of data to write, must not reach outside the buffer
+	*/
+	inline void writeColumn(int16_t x, int16_t y, uint8_t data, uint8_t mask) {
+		y -= _top;
+		data &= mask;
+		const int16_t page = y >> 3; // floor, y may be negative
+		const uint8_t shift = y & 7;
+		if (page >= 0 && (page << 3) < _height) {
+			uint8_t& byte = _buffer[(_width * page) + x];
+			byte = (byte & ~(mask << shift)) | (data << shift);
+		}
+		if (shift && ((page + 1) << 3) < _height) {
+			uint8_t& byte = _buffer[(_width * (page + 1)) + x];
+			byte = (byte & ~(mask >> (8 - shift))) | (data >> (8 - shift));
+		}
+	}
+
+  private:
+	inline static void apply(uint8_t& byte, uint8_t mask, uint8_t color) {
+		switch (color) {
+			case 1: byte |= mask; break;
+			case 0: byte &= ~mask; break;
+			case 2: byte ^= mask; break;
+		}
+	}
+
+	std::span<uint8_t> _buffer; /**< page buffer data */
+	int16_t _width = 0;  /**< width in pixels */
+	int16_t _height = 0; /**< height in pixels */
+	int16_t _top = 0;    /**< screen row of the first buffer row */
+};
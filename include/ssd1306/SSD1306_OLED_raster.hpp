@@ -0,0 +1,364 @@
+/*!
+	@file SSD1306_OLED_raster.hpp
+	@brief OLED driven by SSD1306 controller. Raster algorithms templated on the draw target.
+	@details A target is any class with these members, called only with
+		co-ordinates inside the clip rectangle:
+		-# void plot(int16_t x, int16_t y, uint8_t color)
+		-# void vspan(int16_t x, int16_t y0, int16_t y1, uint8_t color), y0 <= y1
+		-# void hspan(int16_t x0, int16_t x1, int16_t y, uint8_t color), x0 <= x1
+		Instantiated for SSD1306_PageBuffer the pixel access is inlined into
+		each inner loop, SSD1306_graphics also instantiates them for a target
+		that forwards to its virtual drawPixel so rotated and user subclasses
+		keep working. Pixel output matches the original Adafruit style loops.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include "SSD1306_OLED_pagebuffer.hpp"
+
+namespace Raster {
+
+static constexpr int16_t SpanColumnsMax = 128; /**< widest clip fillTriangle collects column spans for */
+static constexpr uint8_t SpanEmpty = 0xFF;     /**< column holds no span yet */
+
+/*!
+	@brief Vertical line from row y to row y+h-1, clipped
+	@note h <= 0 draws the same pixels drawLine(x, y, x, y+h-1) would.
+*/
+template <class Target>
+inline void fastVLine(Target& t, const ClipRect& clip, int16_t x, int16_t y, int16_t h, uint8_t color)
+{
+	int16_t y1 = y + h - 1;
+	if (y1 < y) std::swap(y, y1);
+	if ((x < clip.x0) || (x >= clip.x1)) return;
+	y = std::max(y, clip.y0);
+	y1 = std::min<int16_t>(y1, clip.y1 - 1);
+	if (y <= y1) t.vspan(x, y, y1, color);
+}
+
+/*!
+	@brief Horizontal line from column x to column x+w-1, clipped
+	@note w <= 0 draws the same pixels drawLine(x, y, x+w-1, y) would.
+*/
+template <class Target>
+inline void fastHLine(Target& t, const ClipRect& clip, int16_t x, int16_t y, int16_t w, uint8_t color)
+{
+	int16_t x1 = x + w - 1;
+	if (x1 < x) std::swap(x, x1);
+	if ((y < clip.y0) || (y >= clip.y1)) return;
+	x = std::max(x, clip.x0);
+	x1 = std::min<int16_t>(x1, clip.x1 - 1);
+	if (x <= x1) t.hspan(x, x1, y, color);
+}
+
+/*!
+	@brief Line from (x0,y0) to (x1,y1), run-slice Bresenham, clipped once
+	@details The line is cut into runs of pixels sharing a minor co-ordinate,
+		run length comes from the error term with one division, and each run
+		is one hspan (shallow lines) or one vspan (steep lines, page masks
+		on the buffer). The pixels are exactly those of the per pixel
+		Bresenham loop this replaced.
+*/
+template <class Target>
+void line(Target& t, const ClipRect& clip, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+	const bool steep = abs(y1 - y0) > abs(x1 - x0);
+	if (steep) {
+		std::swap(x0, y0);
+		std::swap(x1, y1);
+	}
+	if (x0 > x1) {
+		std::swap(x0, x1);
+		std::swap(y0, y1);
+	}
+
+	const int16_t dx = x1 - x0;
+	const int16_t dy = abs(y1 - y0);
+	int32_t err = dx / 2;
+	const int16_t ystep = (y0 < y1) ? 1 : -1;
+
+	// Clip against the rectangle once: x is the major axis here, y the minor
+	const int16_t majorMin = steep ? clip.y0 : clip.x0;
+	const int16_t majorMax = (steep ? clip.y1 : clip.x1) - 1;
+	const int16_t minorMin = steep ? clip.x0 : clip.y0;
+	const int16_t minorMax = (steep ? clip.x1 : clip.y1) - 1;
+	if ((x1 < majorMin) || (x0 > majorMax)) return;
+	if ((std::max(y0, y1) < minorMin) || (std::min(y0, y1) > minorMax)) return;
+	if (x0 < majorMin) {
+		// jump k steps, the error term after them has a closed form
+		int32_t k = majorMin - x0;
+		int32_t m = (k * dy) - err;
+		m = (m > 0) ? (m + dx - 1) / dx : 0; // minor steps taken
+		err = err - (k * dy) + (m * dx);
+		y0 += ystep * m;
+		x0 = majorMin;
+	}
+	if (x1 > majorMax) x1 = majorMax;
+
+	// err stays in [0, dx): a run ends on the step that takes it below zero
+	while (x0 <= x1) {
+		int16_t run = x1 - x0 + 1;
+		if (dy != 0 && (err / dy) + 1 < run) run = (err / dy) + 1;
+		if (y0 >= minorMin && y0 <= minorMax) {
+			if (steep) t.vspan(y0, x0, x0 + run - 1, color);
+			else t.hspan(x0, x0 + run - 1, y0, color);
+		} else if ((ystep > 0) == (y0 > minorMax)) {
+			break; // left the clip rectangle for good
+		}
+		x0 += run;
+		err -= static_cast<int32_t>(run) * dy;
+		if (err < 0) {
+			y0 += ystep;
+			err += dx;
+		}
+	}
+}
+
+/*!
+	@brief Filled rectangle, one clipped vertical span per column
+*/
+template <class Target>
+void fillRect(Target& t, const ClipRect& clip, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t color)
+{
+	const int16_t first = std::max(x, clip.x0);
+	const int16_t last = std::min<int16_t>(x + w, clip.x1);
+	for (int16_t i = first; i < last; i++)
+		fastVLine(t, clip, i, y, h, color);
+}
+
+/*!
+	@brief Plot a pixel if it is inside the clip rectangle
+*/
+template <class Target>
+inline void clippedPlot(Target& t, const ClipRect& clip, int16_t x, int16_t y, uint8_t color)
+{
+	if (clip.contains(x, y)) t.plot(x, y, color);
+}
+
+/*!
+	@brief Circle outline, midpoint algorithm
+*/
+template <class Target>
+void circle(Target& t, const ClipRect& clip, int16_t x0, int16_t y0, int16_t r, uint8_t color)
+{
+	if (clip.rejects(x0 - abs(r), y0 - abs(r), 2 * abs(r) + 1, 2 * abs(r) + 1)) return;
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+	clippedPlot(t, clip, x0, y0 + r, color);
+	clippedPlot(t, clip, x0, y0 - r, color);
+	clippedPlot(t, clip, x0 + r, y0, color);
+	clippedPlot(t, clip, x0 - r, y0, color);
+
+	while (x < y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		clippedPlot(t, clip, x0 + x, y0 + y, color);
+		clippedPlot(t, clip, x0 - x, y0 + y, color);
+		clippedPlot(t, clip, x0 + x, y0 - y, color);
+		clippedPlot(t, clip, x0 - x, y0 - y, color);
+		clippedPlot(t, clip, x0 + y, y0 + x, color);
+		clippedPlot(t, clip, x0 - y, y0 + x, color);
+		clippedPlot(t, clip, x0 + y, y0 - x, color);
+		clippedPlot(t, clip, x0 - y, y0 - x, color);
+	}
+}
+
+/*!
+	@brief Quarter circle outlines for rounded rectangles
+	@param cornername bit 0 top left, bit 1 top right, bit 2 bottom right, bit 3 bottom left
+*/
+template <class Target>
+void circleCorners(Target& t, const ClipRect& clip, int16_t x0, int16_t y0, int16_t r, uint8_t cornername, uint8_t color)
+{
+	if (clip.rejects(x0 - abs(r), y0 - abs(r), 2 * abs(r) + 1, 2 * abs(r) + 1)) return;
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+
+	while (x < y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+		if (cornername & 0x4) {
+			clippedPlot(t, clip, x0 + x, y0 + y, color);
+			clippedPlot(t, clip, x0 + y, y0 + x, color);
+		}
+		if (cornername & 0x2) {
+			clippedPlot(t, clip, x0 + x, y0 - y, color);
+			clippedPlot(t, clip, x0 + y, y0 - x, color);
+		}
+		if (cornername & 0x8) {
+			clippedPlot(t, clip, x0 - y, y0 + x, color);
+			clippedPlot(t, clip, x0 - x, y0 + y, color);
+		}
+		if (cornername & 0x1) {
+			clippedPlot(t, clip, x0 - y, y0 - x, color);
+			clippedPlot(t, clip, x0 - x, y0 - y, color);
+		}
+	}
+}
+
+/*!
+	@brief Filled circle halves, stretched down by delta for rounded rectangles
+	@param cornername bit 0 right half, bit 1 left half
+	@param firstColumn columns closer to x0 than this are left to the caller,
+		the centre column x0 always is
+	@note Each column gets one vertical span, its longest, so no pixel is written twice.
+*/
+template <class Target>
+void fillCircleHalves(Target& t, const ClipRect& clip, int16_t x0, int16_t y0, int16_t r,
+	uint8_t cornername, int16_t delta, uint8_t color, int16_t firstColumn = 1)
+{
+	int16_t f = 1 - r;
+	int16_t ddF_x = 1;
+	int16_t ddF_y = -2 * r;
+	int16_t x = 0;
+	int16_t y = r;
+	int16_t px = x;
+	int16_t py = y;
+
+	delta++;
+	while (x < y) {
+		if (f >= 0) {
+			y--;
+			ddF_y += 2;
+			f += ddF_y;
+		}
+		x++;
+		ddF_x += 2;
+		f += ddF_x;
+
+		if (x < (y + 1) && x >= firstColumn) {
+			if (cornername & 0x1) fastVLine(t, clip, x0 + x, y0 - y, 2 * y + delta, color);
+			if (cornername & 0x2) fastVLine(t, clip, x0 - x, y0 - y, 2 * y + delta, color);
+		}
+		if (y != py) {
+			if (py >= firstColumn) {
+				if (cornername & 0x1) fastVLine(t, clip, x0 + py, y0 - px, 2 * px + delta, color);
+				if (cornername & 0x2) fastVLine(t, clip, x0 - py, y0 - px, 2 * px + delta, color);
+			}
+			py = y;
+		}
+		px = x;
+	}
+}
+
+/*!
+	@brief Filled triangle
+	@details Rows are stepped as in the classic scanline fill but collected
+		into one span per column, then each column is written once as a
+		vertical span to suit the page layout. Clip rectangles wider than
+		SpanColumnsMax fall back to one horizontal span per row.
+*/
+template <class Target>
+void fillTriangle(Target& t, const ClipRect& clip, int16_t x0, int16_t y0,
+	int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint8_t color)
+{
+	int16_t a, b, y, last;
+
+	if (y0 > y1) {
+		std::swap(y0, y1); std::swap(x0, x1);
+	}
+	if (y1 > y2) {
+		std::swap(y2, y1); std::swap(x2, x1);
+	}
+	if (y0 > y1) {
+		std::swap(y0, y1); std::swap(x0, x1);
+	}
+
+	if (y0 == y2) {
+		a = b = x0;
+		if (x1 < a)      a = x1;
+		else if (x1 > b) b = x1;
+		if (x2 < a)      a = x2;
+		else if (x2 > b) b = x2;
+		fastHLine(t, clip, a, y0, b - a + 1, color);
+		return;
+	}
+	if (clip.rejects(std::min({x0, x1, x2}), y0, std::max({x0, x1, x2}) - std::min({x0, x1, x2}) + 1, y2 - y0 + 1)) return;
+
+	const int16_t
+		dx01 = x1 - x0,
+		dy01 = y1 - y0,
+		dx02 = x2 - x0,
+		dy02 = y2 - y0,
+		dx12 = x2 - x1,
+		dy12 = y2 - y1;
+	int32_t
+		sa = 0,
+		sb = 0;
+
+	const bool columnSpans = (clip.x1 <= SpanColumnsMax);
+	uint8_t top[SpanColumnsMax];
+	uint8_t bottom[SpanColumnsMax];
+	int16_t left = clip.x1, right = -1;
+	if (columnSpans) memset(top, SpanEmpty, clip.x1);
+
+	auto rowSpan = [&](int16_t a, int16_t b, int16_t y) {
+		if (y < clip.y0 || y >= clip.y1) return;
+		if (a < clip.x0) a = clip.x0;
+		if (b >= clip.x1) b = clip.x1 - 1;
+		if (a > b) return;
+		if (!columnSpans) {
+			t.hspan(a, b, y, color);
+			return;
+		}
+		if (a < left) left = a;
+		if (b > right) right = b;
+		for (int16_t x = a; x <= b; x++) {
+			if (top[x] == SpanEmpty) top[x] = y;
+			bottom[x] = y; // rows arrive top to bottom
+		}
+	};
+
+	if (y1 == y2) last = y1;
+	else          last = y1 - 1;
+
+	for (y = y0; y <= last; y++) {
+		a = x0 + sa / dy01;
+		b = x0 + sb / dy02;
+		sa += dx01;
+		sb += dx02;
+		if (a > b) std::swap(a, b);
+		rowSpan(a, b, y);
+	}
+
+	sa = dx12 * (y - y1);
+	sb = dx02 * (y - y0);
+	for (; y <= y2; y++) {
+		a = x1 + sa / dy12;
+		b = x0 + sb / dy02;
+		sa += dx12;
+		sb += dx02;
+		if (a > b) std::swap(a, b);
+		rowSpan(a, b, y);
+	}
+
+	for (int16_t x = left; x <= right; x++) {
+		if (top[x] != SpanEmpty) t.vspan(x, top[x], bottom[x], color);
+	}
+}
+
+} // namespace Raster
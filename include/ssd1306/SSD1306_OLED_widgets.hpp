@@ -0,0 +1,119 @@
+/*!
+	@file SSD1306_OLED_widgets.hpp
+	@brief OLED driven by SSD1306 controller. Retained display list.
+	@details Widgets live in a fixed pool, no heap. Setters compare the new
+		value with the bound one and only bump the widget version when it
+		changed. render() redraws widgets whose version moved on, each
+		inside its own clip rectangle, and records their bounds as damage.
+		A digits widget remembers the cells it drew and redraws only the
+		span of cells that changed. With a background layer set, cleared
+		areas are copied back from it, so static labels are drawn once.
+		flush() sends just the damaged regions to the screen.
+*/
+
+#pragma once
+
+#include <array>
+#include <span>
+#include "SSD1306_OLED.hpp"
+
+/*! @brief Fixed size retained display list of widgets */
+class SSD1306_DisplayList
+{
+  public:
+	static constexpr uint8_t MaxWidgets = 12;    /**< widget pool size */
+	static constexpr uint8_t MaxDamage = 6;      /**< damage rectangles kept before merging */
+	static constexpr uint8_t MaxTextLength = 21; /**< characters held by a text widget, one 6x8 row */
+	static constexpr uint8_t MaxDigitWidgets = 2; /**< digits widgets with a cell cache */
+	static constexpr uint8_t MaxDigits = 8;       /**< characters held by a digits widget */
+
+	/*! Widget kinds */
+	enum WidgetType_e : uint8_t
+	{
+		WidgetFree = 0,   /**< pool slot not in use */
+		WidgetText = 1,   /**< text string */
+		WidgetNumber = 2, /**< fixed point integer */
+		WidgetIcon = 3,   /**< horizontally addressed bitmap, as OLEDBitmap */
+		WidgetBar = 4,    /**< horizontal bar graph */
+		WidgetChart = 5,  /**< polyline of caller owned samples */
+		WidgetDigits = 6  /**< big number text, redrawn per changed character cell */
+	};
+
+	explicit SSD1306_DisplayList(SSD1306& display);
+
+	DisplayRet::Ret_Codes_e addText(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+		std::span<const uint8_t> font, SSD1306_graphics::text_align_e align = SSD1306_graphics::alignLeft, uint8_t scale = 1);
+	DisplayRet::Ret_Codes_e addNumber(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+		std::span<const uint8_t> font, uint8_t decimals, SSD1306_graphics::text_align_e align = SSD1306_graphics::alignLeft, uint8_t scale = 1);
+	DisplayRet::Ret_Codes_e addDigits(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+		std::span<const uint8_t> font, SSD1306_graphics::text_align_e align = SSD1306_graphics::alignLeft, uint8_t scale = 1);
+	DisplayRet::Ret_Codes_e addIcon(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h, std::span<const uint8_t> bitmap);
+	DisplayRet::Ret_Codes_e addBar(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max);
+	DisplayRet::Ret_Codes_e addChart(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+		std::span<const int16_t> samples, int16_t min, int16_t max);
+	void clear(void);
+
+	DisplayRet::Ret_Codes_e setText(uint8_t id, const char* text);
+	DisplayRet::Ret_Codes_e setNumber(uint8_t id, int32_t value);
+	DisplayRet::Ret_Codes_e setIcon(uint8_t id, std::span<const uint8_t> bitmap);
+	DisplayRet::Ret_Codes_e setBar(uint8_t id, int32_t value);
+	DisplayRet::Ret_Codes_e setTextAlign(uint8_t id, SSD1306_graphics::text_align_e align, int16_t anchor);
+	DisplayRet::Ret_Codes_e setInvert(uint8_t id, bool invert);
+	DisplayRet::Ret_Codes_e touch(uint8_t id);
+
+	void setBackground(std::span<const uint8_t> layer);
+	void invalidateAll(void);
+	void addDamage(int16_t x, int16_t y, int16_t w, int16_t h);
+	uint8_t render(void);
+	void flush(void);
+	void drawAll(void);
+
+  private:
+	/*! @brief One widget record */
+	struct Widget_t
+	{
+		WidgetType_e type = WidgetFree;    /**< kind, WidgetFree when the slot is unused */
+		ClipRect bounds;                   /**< area owned, cleared before a redraw */
+		uint16_t version = 0;              /**< bumped when the bound data changes */
+		uint16_t drawnVersion = 0;         /**< version on screen */
+		bool invert = false;               /**< draw white background, black content */
+		SSD1306_graphics::text_align_e align = SSD1306_graphics::alignLeft; /**< text alignment */
+		int16_t anchor = 0;                /**< x the text is aligned against */
+		uint8_t scale = 1;                 /**< text scale */
+		uint8_t decimals = 0;              /**< number widget fraction digits */
+		uint8_t cells = 0;                 /**< digits widget cell cache slot */
+		std::span<const uint8_t> font;     /**< text font */
+		std::span<const uint8_t> bitmap;   /**< icon data */
+		std::span<const int16_t> samples;  /**< chart data, owned by the caller */
+		int32_t value = 0;                 /**< number, bar or chart value */
+		int32_t min = 0;                   /**< bar and chart range low */
+		int32_t max = 0;                   /**< bar and chart range high */
+		char text[MaxTextLength + 1] = {}; /**< text widget content, number widget rendering */
+	};
+
+	/*! @brief Character cells a digits widget last drew */
+	struct DigitCells_t
+	{
+		bool valid = false;            /**< false until drawn, or after invalidateAll */
+		uint8_t count = 0;             /**< cells in use */
+		char text[MaxDigits] = {};     /**< character of each cell */
+		int16_t x[MaxDigits] = {};     /**< left column of each cell */
+		uint8_t width[MaxDigits] = {}; /**< advance of each cell */
+	};
+
+	DisplayRet::Ret_Codes_e allocate(uint8_t& id, WidgetType_e type, int16_t x, int16_t y, int16_t w, int16_t h);
+	Widget_t* find(uint8_t id, WidgetType_e type);
+	void formatNumber(Widget_t& widget);
+	ClipRect diffDigits(Widget_t& widget);
+	void drawWidget(Widget_t& widget, const ClipRect& area);
+	static bool hasContent(const Widget_t& widget);
+	static bool overlaps(const ClipRect& a, const ClipRect& b);
+
+	SSD1306& _display; /**< display drawn and flushed */
+	std::array<Widget_t, MaxWidgets> _widgets{}; /**< widget pool */
+	std::array<ClipRect, MaxDamage> _damage{};   /**< regions changed since the last flush */
+	uint8_t _damageCount = 0;                    /**< number of entries used in _damage */
+	std::array<DigitCells_t, MaxDigitWidgets> _cells{}; /**< digits widget cell caches */
+	uint8_t _cellsCount = 0;                     /**< number of entries used in _cells */
+	std::span<const uint8_t> _background;        /**< static layer restored under widgets, empty for black */
+};
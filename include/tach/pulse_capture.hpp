@@ -0,0 +1,66 @@
+/*!
+	@file pulse_capture.hpp
+	@brief Tachometer. Hall sensor edge timestamps captured by PIO and DMA.
+	@details A PIO state machine counts system clock cycles and pushes the
+		count on each falling edge of the sensor pin, a DMA channel copies the
+		pushes into a RAM ring. No interrupt runs per pulse, the main loop
+		reads the intervals between edges in batches with readIntervals().
+		Resolution is two system clock cycles, 16 ns at 125 MHz. The DMA
+		transfer count doubles as an edge counter on any pin, see sample().
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/pio.h"
+
+/*! @brief Edge timestamp capture on one pin with one PIO state machine and one DMA channel */
+class PulseCapture
+{
+  public:
+	static constexpr uint32_t RingSize = 256;  /**< timestamps held, a power of two */
+	static constexpr uint32_t RingBytes = RingSize * sizeof(uint32_t); /**< DMA ring wrap size */
+	static constexpr uint32_t CyclesPerCount = 2; /**< system clock cycles per PIO count */
+	static constexpr uint32_t EdgeCycles = 3;     /**< cycles per edge the count does not cover */
+	static_assert((RingSize & (RingSize - 1)) == 0, "capture ring size must be a power of two");
+	static_assert(RingBytes <= 32768, "DMA ring wrap is at most 2^15 bytes");
+
+	bool begin(PIO pio, uint pin);
+	size_t readIntervals(uint32_t* intervals, size_t maxIntervals);
+	void discard(void);
+	uint32_t sample(uint32_t& elapsedUs);
+	uint32_t tickHz(void) const;
+	/*! @brief timestamps overwritten by DMA before they were read, since begin */
+	inline uint32_t lost(void) const { return _lost; }
+
+	/*!
+		@brief Interval between two captured counts
+		@param older count pushed at the earlier edge
+		@param newer count pushed at the later edge
+		@return system clock cycles between the edges, saturated to 32 bits
+		@note The count runs down and wraps, the difference is taken modulo 2^32.
+	*/
+	static constexpr uint32_t intervalCycles(uint32_t older, uint32_t newer)
+	{
+		const uint64_t cycles = static_cast<uint64_t>(CyclesPerCount) * static_cast<uint32_t>(older - newer) + EdgeCycles;
+		return (cycles > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(cycles);
+	}
+
+  private:
+	static constexpr uint32_t DmaRun = UINT32_MAX; /**< transfers per DMA start, restarted when done */
+
+	uint32_t writtenCount(void);
+
+	alignas(RingBytes) volatile uint32_t _ring[RingSize] = {}; /**< DMA destination, wraps on RingBytes */
+	PIO _pio = nullptr;       /**< PIO block, nullptr before begin */
+	uint _sm = 0;             /**< state machine running pulse_capture */
+	int _dma = -1;            /**< DMA channel draining the RX FIFO */
+	uint32_t _runBase = 0;    /**< timestamps written before the current DMA run */
+	uint32_t _read = 0;       /**< timestamps consumed, slot is _read % RingSize */
+	uint32_t _previous = 0;   /**< last count consumed */
+	bool _havePrevious = false; /**< _previous holds a count an interval can start from */
+	uint32_t _lost = 0;       /**< timestamps overwritten before being read */
+	uint32_t _sampleCount = 0; /**< timestamps written at the previous sample */
+	uint32_t _sampleTime = 0;  /**< time_us_32 at the previous sample */
+};
@@ -0,0 +1,28 @@
+/*!
+	@file pulse_counter.hpp
+	@brief Tachometer. Hall sensor edges counted by a PWM slice.
+	@details The PWM slice of the sensor pin runs with its B input as the
+		clock, the counter advances once per falling edge with no CPU work.
+		The main loop calls sample() every pass and sums edges and elapsed
+		time over a gate, the edge rate of the gate is then edges / time.
+		Only B inputs, the odd GPIOs, can clock a slice.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include "pico/types.h"
+
+/*! @brief Falling edge counter on the B pin of one PWM slice */
+class PulseCounter
+{
+  public:
+	bool begin(uint pin);
+	uint32_t sample(uint32_t& elapsedUs);
+
+  private:
+	uint _slice = 0;         /**< PWM slice of the pin */
+	bool _running = false;   /**< begin succeeded */
+	uint16_t _lastCount = 0; /**< counter at the previous sample */
+	uint32_t _lastTime = 0;  /**< time_us_32 at the previous sample */
+};
@@ -0,0 +1,106 @@
+/*!
+	@file spsc_ring.hpp
+	@brief Tachometer. Lock free ring between one producer and one consumer.
+	@details Meant for an interrupt handler handing values to the main loop.
+		Each index is written by one side only and is a single 32 bit store,
+		a value is published by a barrier and then the head store, so neither
+		side ever sees a half written value or index. A push to a full ring
+		is dropped and counted, the producer never waits. The next value
+		pushed after a drop is marked, pop() reports the mark so the consumer
+		breaks continuity exactly there and keeps every other value.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/sync.h"
+
+/*!
+	@brief Single producer single consumer ring of N values
+	@tparam T value type, copied in and out
+	@tparam N capacity, a power of two
+*/
+template <typename T, uint32_t N>
+class SpscRing
+{
+  public:
+	static_assert(N > 0 && (N & (N - 1)) == 0, "ring size must be a power of two");
+
+	/*!
+		@brief Add a value, producer side only
+		@param value value to add
+		@return false if the ring was full, the value is dropped and counted in overflows()
+	*/
+	bool push(const T& value)
+	{
+		const uint32_t head = _head;
+		if (head - _tail >= N)
+		{
+			_overflows = _overflows + 1;
+			_dropped = true;
+			return false;
+		}
+		const uint32_t slot = head % N;
+		_slots[slot] = value;
+		if (_dropped) _gaps[slot / 32] |= (1u << (slot % 32));
+		else _gaps[slot / 32] &= ~(1u << (slot % 32));
+		_dropped = false;
+		__dmb();
+		_head = head + 1;
+		return true;
+	}
+
+	/*!
+		@brief Take the oldest values, consumer side only
+		@param values destination
+		@param maxValues size of values, the rest stays for the next call
+		@param gap set true if values were dropped just before values[0]
+		@return values taken, oldest first
+		@note A batch never spans dropped values, it ends before the next
+			value that follows a drop, which starts the next batch.
+	*/
+	size_t pop(T* values, size_t maxValues, bool& gap)
+	{
+		const uint32_t tail = _tail;
+		const uint32_t available = _head - tail;
+		__dmb();
+		size_t count = (available < maxValues) ? available : maxValues;
+		gap = (count > 0) && gapBefore(tail % N);
+		for (size_t i = 0; i < count; i++)
+		{
+			const uint32_t slot = (tail + i) % N;
+			if (i > 0 && gapBefore(slot))
+			{
+				count = i;
+				break;
+			}
+			values[i] = _slots[slot];
+		}
+		__dmb();
+		_tail = tail + count;
+		return count;
+	}
+
+	/*! @brief Drop every value held, consumer side only */
+	void clear(void)
+	{
+		const uint32_t head = _head;
+		__dmb();
+		_tail = head;
+	}
+
+	/*! @brief Values dropped because the ring was full, since start up */
+	uint32_t overflows(void) const { return _overflows; }
+
+  private:
+	/*! @brief true if values were dropped just before the value in slot */
+	bool gapBefore(uint32_t slot) const { return _gaps[slot / 32] & (1u << (slot % 32)); }
+
+	T _slots[N];                       /**< values, slot is index % N */
+	uint32_t _gaps[(N + 31) / 32] = {}; /**< bit per slot, drops before its value, producer writes */
+	volatile uint32_t _head = 0;       /**< values pushed, producer writes */
+	volatile uint32_t _tail = 0;       /**< values popped, consumer writes */
+	volatile uint32_t _overflows = 0;  /**< pushes dropped, producer writes */
+	bool _dropped = false;             /**< a push was dropped since the last stored value, producer only */
+};
@@ -13,18 +13,37 @@
 #include "hardware/sync.h"
 #include "ssd1306/SSD1306_OLED.hpp"
 #include "ssd1306/SSD1306_OLED_font.hpp"
+#include "ssd1306/SSD1306_OLED_widgets.hpp"
+#include "ssd1306/SSD1306_OLED_console.hpp"
+#include "ssd1306/SSD1306_OLED_graphs.hpp"
+#include "ssd1306/SSD1306_OLED_format.hpp"
+#include "ssd1306/SSD1306_OLED_log.hpp"
+#include "tach/pulse_counter.hpp"
+#include "tach/spsc_ring.hpp"
+#ifdef TACH_PULSE_CAPTURE_PIO
+#include "tach/pulse_capture.hpp"
+#endif
 
 // Screen settings
 #define myOLEDwidth  128
 #define myOLEDheight 64
 #define myScreenSize (myOLEDwidth * (myOLEDheight/8)) // eg 1024 bytes = 128 * 64/8
 uint8_t screenBuffer[myScreenSize]; // Define a buffer to cover whole screen  128 * 64/8
+uint8_t backgroundBuffer[myScreenSize]; // Static labels of the RPM or gauge screen, drawn each time it is entered
 
 // Display timing parameters
 #define DISPLAY_UPDATE_INTERVAL 100  // Update display every 100ms (was 250ms)
 #define MENU_TIMEOUT 5000          // Exit menu after 5 seconds of inactivity
 #define RPM_TIMEOUT_MS 500          // Timeout for zero RPM
 #define RPM_TIMEOUT_CHECK_MS 100    // Check for timeout every 100ms (was 1000ms)
+#define RPM_GRAPH_FULL_SCALE 3000   // RPM at the top of the history graph and the end of the bar
+#define RPM_HISTORY_BUCKET 5        // Display updates per history column, 100 columns = 50 seconds
+#define GAUGE_DIVISIONS 3           // Major gauge ticks, labelled in thousands of RPM
+
+// Measurement mode parameters, edges are timed at low rates and counted over a gate at high rates
+#define FREQ_GATE_MS 200            // Gate time of the edge count, 1 count in 4000 at the switch rate
+#define FREQ_MODE_ENTER_HZ 20000.0f // Edge rate above which edges are counted
+#define FREQ_MODE_EXIT_HZ 16000.0f  // Edge rate below which edges are timed again, hysteresis
 
 // I2C settings
 const uint16_t I2C_Speed = 1000;
@@ -32,7 +51,10 @@ const uint8_t I2C_GPIO_CLK = 7;
 const uint8_t I2C_GPIO_DATA = 6;
 
 // Hall sensor and button settings
-const uint8_t HALL_SENSOR_PIN = 12;    // GPIO pin for hall sensor input
+#ifndef TACH_HALL_SENSOR_PIN
+#define TACH_HALL_SENSOR_PIN 12     // Set by the build option of the same name
+#endif
+const uint8_t HALL_SENSOR_PIN = TACH_HALL_SENSOR_PIN; // GPIO pin for hall sensor input
 const uint8_t BUTTON_UP_PIN = 10;      // GPIO pin for UP button
 const uint8_t BUTTON_DOWN_PIN = 11;    // GPIO pin for DOWN button
 const uint8_t BUTTON_MENU_PIN = 9;     // GPIO pin for MENU button
@@ -52,9 +74,16 @@ typedef struct {
     uint8_t filter_strength;     // Filter strength (0-10, 0=no filtering)
     float workpiece_diameter;    // Diameter of the workpiece
     bool use_inches;             // true = inches, false = mm
+    uint8_t display_mode;        // DISPLAY_DIGITS or DISPLAY_GAUGE
 } tach_settings_t;
 
-#define SETTINGS_MAGIC 0xABCD1234 // Magic number to validate settings
+#define SETTINGS_MAGIC 0xABCD1235 // Magic number to validate settings, changed with the settings layout
+
+// RPM screen styles
+enum DisplayMode {
+    DISPLAY_DIGITS,
+    DISPLAY_GAUGE
+};
 
 // Menu states
 enum MenuState {
@@ -64,16 +93,48 @@ enum MenuState {
     MENU_DECIMAL,
     MENU_FILTER,
     MENU_DIAMETER,
-    MENU_UNITS
+    MENU_UNITS,
+    MENU_DISPLAY
+};
+
+// How RPM is measured
+enum measure_mode_e {
+    MEASURE_PERIOD,     // Average interval between edges, precise at low rates
+    MEASURE_FREQUENCY   // Edges counted in hardware over a gate, no work per edge
+};
+
+// What counts the edges of the frequency mode gate
+enum gate_source_e {
+    GATE_NONE,          // Nothing, period measurement only
+    GATE_PWM,           // PWM slice of the pin, B inputs only
+    GATE_PIO            // DMA transfers of the PIO capture, any pin
 };
 
 // Global variables
-volatile uint32_t pulse_count = 0;               // Counter for hall sensor pulses
-volatile uint64_t last_pulse_time = 0;           // Time of last pulse
-volatile uint64_t current_pulse_time = 0;        // Time of current pulse
-volatile uint64_t pulse_interval_sum = 0;        // Sum of pulse intervals
-volatile uint8_t pulse_intervals_count = 0;      // Count of measured intervals
-volatile bool rpm_data_ready = false;            // Flag for new RPM data
+// Edge timestamps queued by the interrupt for the main loop, 2048 edges cover 100 ms at the 20 kHz
+// period mode ceiling, longer than a full screen flush even at 100 kHz I2C. A flash save
+// masks interrupts, its edges are missed rather than queued.
+const uint32_t PULSE_RING_SIZE = 2048;
+SpscRing<uint32_t, PULSE_RING_SIZE> pulse_ring;  // Edge timestamps from the interrupt, time_us_32
+uint32_t pulse_ring_overflows = 0;               // pulse_ring.overflows() when last checked
+uint32_t last_edge_time = 0;                     // Timestamp of the last edge taken from pulse_ring
+bool have_last_edge = false;                     // last_edge_time can start the next interval
+uint32_t pulse_count = 0;                        // Counter for hall sensor pulses
+uint64_t current_pulse_time = 0;                 // Time the last pulses were taken in
+uint64_t pulse_interval_sum = 0;                 // Sum of pulse intervals
+uint32_t pulse_intervals_count = 0;              // Count of measured intervals
+bool rpm_data_ready = false;                     // Flag for new RPM data
+uint32_t pulse_tick_hz = 1000000;                // Rate of the interval sum, microseconds from the interrupt
+#ifdef TACH_PULSE_CAPTURE_PIO
+PulseCapture hall_capture;                       // Hall sensor edges timestamped by PIO and DMA
+bool hall_capture_active = false;                // PIO capture running, else the GPIO interrupt counts
+#endif
+bool hall_irq_active = false;                    // Hall sensor edges timed by the GPIO interrupt
+PulseCounter hall_counter;                       // Hall sensor edges counted by the PWM slice
+uint8_t gate_source = GATE_NONE;                 // Current gate_source_e, frequency mode possible unless GATE_NONE
+uint8_t measure_mode = MEASURE_PERIOD;           // Current measure_mode_e
+uint32_t gate_edges = 0;                         // Edges counted in the current gate
+uint32_t gate_time_us = 0;                       // Length of the current gate so far
 volatile float current_rpm = 0.0f;               // Current calculated RPM
 volatile float filtered_rpm = 0.0f;              // Filtered RPM value
 tach_settings_t settings;                        // Tachometer settings
@@ -102,6 +163,24 @@ uint32_t menu_last_activity = 0;
 // instantiate an OLED object
 SSD1306 myOLED(myOLEDwidth, myOLEDheight);
 
+// RPM screen widgets, only the ones whose text changed are redrawn and sent
+SSD1306_DisplayList rpmScreen(myOLED);
+uint8_t rpm_high_widget = 0;   // "HIGH RPM" banner
+uint8_t rpm_value_widget = 0;  // big segment digits, only changed digit cells are redrawn
+uint8_t rpm_status_widget = 0; // surface speed value, after the "D:... SFM:" label in the background
+// RPM history and bar on the free page between the digits and the status line, updated in place
+SSD1306_Sparkline rpmHistory(myOLED, 0, 48, 100, 8, 0, RPM_GRAPH_FULL_SCALE, RPM_HISTORY_BUCKET);
+SSD1306_BarGraph rpmBar(myOLED, 102, 49, 26, 6, 0, RPM_GRAPH_FULL_SCALE);
+
+// Gauge screen, a half circle dial cached in the background, only the needle and the RPM text change
+SSD1306_DisplayList gaugeScreen(myOLED);
+uint8_t gauge_value_widget = 0; // RPM text under the dial
+SSD1306_Gauge rpmGauge(myOLED, 64, 50, 46, 30, FixedTrig::AngleSteps / 2, FixedTrig::AngleSteps / 2, 0, RPM_GRAPH_FULL_SCALE);
+
+// Menu screen, a 21x8 text console that only redraws and sends the cells that changed
+SSD1306_Console menuConsole(myOLED);
+const char* const menu_captions[] = {"Pulses per rev: ", "Gear ratio: ", "Show decimal: ", "Filter: ", "Diameter: ", "Units: ", "Display: "};
+
 // GPIO interrupt handler
 void gpio_callback(uint gpio, uint32_t events);
 
@@ -131,7 +210,19 @@ void load_settings(void);
 void save_settings(void);
 void display_rpm(void);
 void display_menu(void);
+void draw_rpm_background(void);
+void display_gauge(void);
+void draw_gauge_background(void);
 void calculate_rpm(void);
+void add_pulse_intervals(const uint32_t* intervals, size_t count);
+void collect_interrupt_pulses(void);
+void apply_rpm(float new_rpm);
+uint32_t count_gate_edges(uint32_t& elapsed_us);
+void update_gate(void);
+void set_measure_mode(uint8_t mode);
+#ifdef TACH_PULSE_CAPTURE_PIO
+void collect_captured_pulses(void);
+#endif
 
 // Calculate surface speed based on RPM and workpiece diameter
 float calculate_surface_speed() {
@@ -158,6 +249,8 @@ int main()
 {
     uint32_t last_display_update = 0;
     uint32_t last_timeout_check = 0;
+    bool rpm_screen_shown = false;
+    uint8_t shown_display_mode = DISPLAY_DIGITS;
     
     // Initialize everything
     setup();
@@ -169,25 +262,76 @@ int main()
         // Process button presses
         process_buttons();
         
-        // Calculate RPM when new data is available
-        if (rpm_data_ready) {
-            calculate_rpm();
-            rpm_data_ready = false;
+        // Count the edges of the gate, switches the measurement mode and gives the RPM in frequency mode
+        if (gate_source != GATE_NONE) {
+            update_gate();
         }
         
-        // Periodically check for RPM timeout (faster checks for more responsive zero)
-        if (current_time - last_timeout_check >= RPM_TIMEOUT_CHECK_MS) {
-            calculate_rpm(); // Will reset RPM to zero if no pulses within timeout period
-            last_timeout_check = current_time;
+        if (measure_mode == MEASURE_PERIOD) {
+            // Take the edges the interrupt queued since the last pass
+            if (hall_irq_active) {
+                collect_interrupt_pulses();
+            }
+#ifdef TACH_PULSE_CAPTURE_PIO
+            // Take the edges PIO and DMA captured since the last pass
+            if (hall_capture_active) {
+                collect_captured_pulses();
+            }
+#endif
+            
+            // Calculate RPM when new data is available
+            if (rpm_data_ready) {
+                calculate_rpm();
+                rpm_data_ready = false;
+            }
+            
+            // Periodically check for RPM timeout (faster checks for more responsive zero)
+            if (current_time - last_timeout_check >= RPM_TIMEOUT_CHECK_MS) {
+                calculate_rpm(); // Will reset RPM to zero if no pulses within timeout period
+                last_timeout_check = current_time;
+            }
+        }
+#ifdef TACH_PULSE_CAPTURE_PIO
+        else if (hall_capture_active) {
+            // The edges are counted, the timestamps are not needed
+            hall_capture.discard();
         }
+#endif
         
         // Update display periodically (faster updates for more responsive display)
         if (current_time - last_display_update >= DISPLAY_UPDATE_INTERVAL) {
-            myOLED.OLEDclearBuffer();
-            
             if (current_menu == MENU_NONE) {
-                display_rpm();
+                // The menu drew over the whole buffer, start the RPM screen afresh
+                if (!rpm_screen_shown) {
+                    shown_display_mode = settings.display_mode;
+                    if (shown_display_mode == DISPLAY_GAUGE) {
+                        draw_gauge_background();
+                        rpmGauge.redraw();
+                        gaugeScreen.invalidateAll();
+                    } else {
+                        draw_rpm_background();
+                        rpmHistory.redraw();
+                        rpmBar.redraw();
+                        rpmScreen.invalidateAll();
+                    }
+                    rpm_screen_shown = true;
+                }
+                if (shown_display_mode == DISPLAY_GAUGE) {
+                    display_gauge();
+                    gaugeScreen.render();
+                    gaugeScreen.flush();
+                } else {
+                    display_rpm();
+                    rpmScreen.render();
+                    rpmScreen.flush();
+                }
             } else {
+                // The RPM screen drew over the whole buffer, start the console afresh
+                if (rpm_screen_shown) {
+                    myOLED.OLEDclearBuffer();
+                    menuConsole.invalidate();
+                    rpm_screen_shown = false;
+                }
                 display_menu();
                 
                 // Check for menu timeout
@@ -195,12 +339,16 @@ int main()
                     current_menu = MENU_NONE;
                     save_settings();
                 }
+                menuConsole.render();
+                menuConsole.flush();
             }
             
-            myOLED.OLEDupdate();
             last_display_update = current_time;
         }
         
+        // Print the diagnostics logged since the last pass, off the drawing and interrupt paths
+        DeferredLog::drain();
+        
         // Small delay to avoid hogging CPU
         sleep_ms(5); // Reduced from 10ms for more responsive system
     }
@@ -209,24 +357,10 @@ int main()
 // GPIO interrupt handler for hall sensor and buttons
 void gpio_callback(uint gpio, uint32_t events) {
     // Process hall sensor interrupts
+    // Only the timestamp is queued, the main loop forms the intervals
+    // A full ring drops the edge and counts it in pulse_ring.overflows()
     if (gpio == HALL_SENSOR_PIN) {
-        pulse_count = pulse_count + 1; // Avoid ++ on volatile
-        
-        // Calculate time between pulses for RPM calculation
-        last_pulse_time = current_pulse_time;
-        current_pulse_time = time_us_64();
-        
-        if (last_pulse_time > 0) {
-            uint64_t interval = current_pulse_time - last_pulse_time;
-            
-            // Add to running average calculation
-            pulse_interval_sum += interval;
-            pulse_intervals_count = pulse_intervals_count + 1; // Avoid ++ on volatile
-            
-            // Signal that we can calculate RPM after each pulse for faster response
-            // This is more responsive than waiting for settings.pulses_per_rev pulses
-            rpm_data_ready = true;
-        }
+        pulse_ring.push(time_us_32());
     }
     
     // Process button interrupts - only capture press/release events
@@ -306,11 +440,40 @@ void setup()
     gpio_set_dir(BUTTON_MENU_PIN, GPIO_IN);
     gpio_pull_up(BUTTON_MENU_PIN);
     
-    // Configure GPIO interrupts for hall sensor and buttons
-    gpio_set_irq_enabled_with_callback(HALL_SENSOR_PIN, GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
-    gpio_set_irq_enabled(BUTTON_UP_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    // Configure GPIO interrupts for the buttons
+    gpio_set_irq_enabled_with_callback(BUTTON_UP_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &gpio_callback);
     gpio_set_irq_enabled(BUTTON_DOWN_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
     gpio_set_irq_enabled(BUTTON_MENU_PIN, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    
+    // Hall sensor edges go to PIO and DMA, or to the GPIO interrupt if no PIO state machine or DMA channel is free
+#ifdef TACH_PULSE_CAPTURE_PIO
+    hall_capture_active = hall_capture.begin(pio0, HALL_SENSOR_PIN);
+    if (hall_capture_active) {
+        pulse_tick_hz = hall_capture.tickHz();
+    } else {
+        printf("Setup: PIO capture unavailable, hall sensor on GPIO interrupt\r\n");
+        hall_irq_active = true;
+    }
+#else
+    hall_irq_active = true;
+#endif
+    if (hall_irq_active) {
+        gpio_set_irq_enabled(HALL_SENSOR_PIN, GPIO_IRQ_EDGE_FALL, true);
+    }
+    
+    // The edges are counted as well, fast sensors are measured by the count. The PWM slice
+    // of a B input counts them, on other pins the DMA transfers of the PIO capture do.
+    if (hall_counter.begin(HALL_SENSOR_PIN)) {
+        gate_source = GATE_PWM;
+    }
+#ifdef TACH_PULSE_CAPTURE_PIO
+    else if (hall_capture_active) {
+        gate_source = GATE_PIO;
+    }
+#endif
+    else {
+        printf("Setup: hall sensor edges cannot be counted on this pin, period measurement only\r\n");
+    }
 
     // Display welcome message
     myOLED.setFont(pFontWide);
@@ -332,6 +495,16 @@ void setup()
     myOLED.OLEDupdate();
     busy_wait_ms(2000);
     myOLED.OLEDclearBuffer();
+
+    // Lay out the RPM screen
+    rpmScreen.addText(rpm_high_widget, 0, 16, myOLEDwidth, 16, pFontDefault, SSD1306_graphics::alignCenter, 2);
+    rpmScreen.addDigits(rpm_value_widget, 0, 0, myOLEDwidth, 48, pFontSixteenSegProp, SSD1306_graphics::alignRight);
+    rpmScreen.addText(rpm_status_widget, 0, 56, myOLEDwidth, 8, pFontDefault);
+    rpmScreen.setBackground(backgroundBuffer);
+    
+    // Lay out the gauge screen
+    gaugeScreen.addText(gauge_value_widget, 0, 56, myOLEDwidth, 8, pFontDefault, SSD1306_graphics::alignCenter);
+    gaugeScreen.setBackground(backgroundBuffer);
 }
 
 // Process button presses for UI control
@@ -428,9 +601,11 @@ void process_buttons() {
                 if (!settings.use_inches) {
                     settings.use_inches = true;
                     convert_diameter_units(false); // Convert from mm to inches
-                    printf("UP: Units changed to inches\n");
+                    DeferredLog::log("UP: Units changed to inches\n");
                     save_settings();
                 }
+            } else if (current_menu == MENU_DISPLAY) {
+                settings.display_mode = (settings.display_mode == DISPLAY_GAUGE) ? DISPLAY_DIGITS : DISPLAY_GAUGE;
             }
             
             menu_last_activity = ms_time;
@@ -498,9 +673,11 @@ void process_buttons() {
                 if (settings.use_inches) {
                     settings.use_inches = false;
                     convert_diameter_units(true); // Convert from inches to mm
-                    printf("DOWN: Units changed to metric\n");
+                    DeferredLog::log("DOWN: Units changed to metric\n");
                     save_settings();
                 }
+            } else if (current_menu == MENU_DISPLAY) {
+                settings.display_mode = (settings.display_mode == DISPLAY_GAUGE) ? DISPLAY_DIGITS : DISPLAY_GAUGE;
             }
             
             menu_last_activity = ms_time;
@@ -536,6 +713,9 @@ void process_buttons() {
                         current_menu = MENU_UNITS;
                         break;
                     case MENU_UNITS:
+                        current_menu = MENU_DISPLAY;
+                        break;
+                    case MENU_DISPLAY:
                         current_menu = MENU_PULSES;  // Cycle back to first menu item
                         break;
                     default:
@@ -551,14 +731,68 @@ void process_buttons() {
     }
 }
 
+// Add pulse intervals, in ticks of pulse_tick_hz, to the running average for calculate_rpm
+void add_pulse_intervals(const uint32_t* intervals, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    for (size_t i = 0; i < count; i++) {
+        pulse_interval_sum += intervals[i];
+    }
+    pulse_intervals_count += count;
+    pulse_count += count;
+    
+    // The edges came in since the last pass, a few milliseconds at most
+    current_pulse_time = time_us_64();
+    
+    // Signal that we can calculate RPM after each pulse for faster response
+    // This is more responsive than waiting for settings.pulses_per_rev pulses
+    rpm_data_ready = true;
+}
+
+// Form the intervals between the edge timestamps the interrupt queued, in microseconds
+void collect_interrupt_pulses() {
+    uint32_t stamps[32];
+    uint32_t intervals[32];
+    size_t count;
+    bool gap;
+    while ((count = pulse_ring.pop(stamps, 32, gap)) > 0) {
+        // Edges were dropped while the ring was full, no interval spans the gap before stamps[0]
+        if (gap) {
+            uint32_t overflows = pulse_ring.overflows();
+            DeferredLog::log("Pulse ring full, %u edges dropped\r\n", overflows - pulse_ring_overflows);
+            pulse_ring_overflows = overflows;
+            have_last_edge = false;
+        }
+        
+        size_t interval_count = 0;
+        for (size_t i = 0; i < count; i++) {
+            if (have_last_edge) {
+                intervals[interval_count++] = stamps[i] - last_edge_time;
+            }
+            last_edge_time = stamps[i];
+            have_last_edge = true;
+        }
+        add_pulse_intervals(intervals, interval_count);
+    }
+}
+
+#ifdef TACH_PULSE_CAPTURE_PIO
+// Add the intervals captured by PIO and DMA to the running average, in system clock cycles
+void collect_captured_pulses() {
+    uint32_t intervals[32];
+    size_t count;
+    while ((count = hall_capture.readIntervals(intervals, 32)) > 0) {
+        add_pulse_intervals(intervals, count);
+    }
+}
+#endif
+
 // Calculate RPM based on pulse timing
 void calculate_rpm() {
     // Timeout detection - if no pulses for a set period, set RPM to 0
     uint64_t current_time = time_us_64();
     
-    // Store previous RPM for rate-of-change detection
-    float previous_rpm = current_rpm;
-    
     // If no pulses received for timeout period, set RPM to zero
     if (current_time - current_pulse_time > RPM_TIMEOUT_MS * 1000) {
         current_rpm = 0;
@@ -572,40 +806,14 @@ void calculate_rpm() {
     
     // Process even if we have just one pulse interval (for faster response)
     if (pulse_intervals_count > 0) {
-        // Calculate average pulse interval in microseconds
+        // Calculate average pulse interval in ticks of pulse_tick_hz
         uint64_t avg_interval = pulse_interval_sum / pulse_intervals_count;
 
         // Avoid division by zero
         if (avg_interval > 0) {
-            // Convert to RPM: 60 seconds * 1,000,000 microseconds / average interval time / pulses per rev
+            // Convert to RPM: 60 seconds * ticks per second / average interval time / pulses per rev
             // Apply gear ratio adjustment
-            float new_rpm = (60.0f * 1000000.0f) / avg_interval / settings.pulses_per_rev * settings.gear_ratio;
-            
-            // Detect rapid deceleration (RPM dropping quickly)
-            bool rapid_deceleration = (previous_rpm > 10.0f && new_rpm < previous_rpm * 0.7f);
-            
-            // Apply low-pass filter if enabled and not rapidly decelerating
-            if (settings.filter_strength > 0 && !rapid_deceleration) {
-                // Calculate filter coefficient (0-1 range)
-                // Higher filter_strength = more filtering (smoother, slower response)
-                float filter_alpha = settings.filter_strength / 10.0f;
-                
-                if (filtered_rpm == 0) {
-                    // Initialize filter with first reading
-                    filtered_rpm = new_rpm;
-                } else {
-                    // Apply exponential moving average filter
-                    // filtered = prev * alpha + new * (1-alpha)
-                    filtered_rpm = (filtered_rpm * filter_alpha) + (new_rpm * (1.0f - filter_alpha));
-                }
-                
-                // Use filtered value
-                current_rpm = filtered_rpm;
-            } else {
-                // No filtering or rapid deceleration - respond quickly
-                current_rpm = new_rpm;
-                filtered_rpm = new_rpm;
-            }
+            apply_rpm((60.0f * pulse_tick_hz) / avg_interval / settings.pulses_per_rev * settings.gear_ratio);
         }
         
         // Reset for next calculation
@@ -614,243 +822,208 @@ void calculate_rpm() {
     }
 }
 
-// Display the current RPM
+// Filter a new RPM reading of either measurement mode into current_rpm
+void apply_rpm(float new_rpm) {
+    // Detect rapid deceleration (RPM dropping quickly)
+    bool rapid_deceleration = (current_rpm > 10.0f && new_rpm < current_rpm * 0.7f);
+    
+    // Apply low-pass filter if enabled and not rapidly decelerating
+    if (settings.filter_strength > 0 && !rapid_deceleration) {
+        // Calculate filter coefficient (0-1 range)
+        // Higher filter_strength = more filtering (smoother, slower response)
+        float filter_alpha = settings.filter_strength / 10.0f;
+        
+        if (filtered_rpm == 0) {
+            // Initialize filter with first reading
+            filtered_rpm = new_rpm;
+        } else {
+            // Apply exponential moving average filter
+            // filtered = prev * alpha + new * (1-alpha)
+            filtered_rpm = (filtered_rpm * filter_alpha) + (new_rpm * (1.0f - filter_alpha));
+        }
+        
+        // Use filtered value
+        current_rpm = filtered_rpm;
+    } else {
+        // No filtering or rapid deceleration - respond quickly
+        current_rpm = new_rpm;
+        filtered_rpm = new_rpm;
+    }
+}
+
+// Edges the gate source counted since the last call
+uint32_t count_gate_edges(uint32_t& elapsed_us) {
+#ifdef TACH_PULSE_CAPTURE_PIO
+    if (gate_source == GATE_PIO) {
+        return hall_capture.sample(elapsed_us);
+    }
+#endif
+    return hall_counter.sample(elapsed_us);
+}
+
+// Sum the edges counted since the last pass. At the end of each gate pick the
+// measurement mode from the edge rate, and in frequency mode take the RPM from it.
+void update_gate() {
+    uint32_t elapsed_us;
+    gate_edges += count_gate_edges(elapsed_us);
+    gate_time_us += elapsed_us;
+    if (gate_time_us < FREQ_GATE_MS * 1000) {
+        return;
+    }
+    
+    float edge_rate = gate_edges * 1000000.0f / gate_time_us;
+    gate_edges = 0;
+    gate_time_us = 0;
+    
+    if (measure_mode == MEASURE_PERIOD && edge_rate > FREQ_MODE_ENTER_HZ) {
+        set_measure_mode(MEASURE_FREQUENCY);
+    } else if (measure_mode == MEASURE_FREQUENCY && edge_rate < FREQ_MODE_EXIT_HZ) {
+        set_measure_mode(MEASURE_PERIOD);
+    }
+    
+    // The gate that switched to frequency mode is its first reading, the display does not stall
+    if (measure_mode == MEASURE_FREQUENCY) {
+        apply_rpm(60.0f * edge_rate / settings.pulses_per_rev * settings.gear_ratio);
+    }
+}
+
+// Hand the hall sensor over between timing and counting its edges
+void set_measure_mode(uint8_t mode) {
+    measure_mode = mode;
+    if (mode == MEASURE_PERIOD) {
+        // Timing restarts at the next edge, the RPM of the last gate holds until the first interval
+        pulse_interval_sum = 0;
+        pulse_intervals_count = 0;
+        current_pulse_time = time_us_64();
+        pulse_ring.clear();
+        have_last_edge = false;
+#ifdef TACH_PULSE_CAPTURE_PIO
+        if (hall_capture_active) {
+            hall_capture.discard();
+        }
+#endif
+    }
+    // No interrupt per edge while the edges are counted
+    if (hall_irq_active) {
+        gpio_set_irq_enabled(HALL_SENSOR_PIN, GPIO_IRQ_EDGE_FALL, mode == MEASURE_PERIOD);
+    }
+    DeferredLog::log(mode == MEASURE_PERIOD ? "Measure mode: period\r\n" : "Measure mode: frequency\r\n");
+}
+
+// Bind the current RPM to the RPM screen widgets, drawing is left to rpmScreen.render()
 void display_rpm() {
-    // Use large segment display font for RPM display
-    myOLED.setFont(pFontSixteenSeg);
-    myOLED.setInvertFont(false);
+    char buffer[SSD1306_DisplayList::MaxTextLength + 1];
     
     // Display RPM value
     if (current_rpm < 10000) {
-        char buffer[10];
-        
         if (settings.show_decimal && current_rpm < 100) {
             // Format with one decimal place for low RPMs
-            sprintf(buffer, "%.1f", current_rpm);
+            FixedFormat::formatFixed(buffer, sizeof(buffer), FixedFormat::toFixed(current_rpm, 1), 0, 1);
         } else {
             // Format as integer for higher RPMs
-            sprintf(buffer, "%d", (int)current_rpm);
+            FixedFormat::formatFixed(buffer, sizeof(buffer), (int32_t)current_rpm, 0, 0);
         }
         
-        // Calculate the width of the text to position it properly
-        // For pFontSixteenSeg, each character is approximately 32 pixels wide
-        // OLED width is 128 pixels
-        int char_width = 32;
-        int text_width = strlen(buffer) * char_width;
-        int x_position = 0;
-        
         // Right justify if less than 1000, otherwise left justify
+        // Widths come from the font metrics, narrow '1' and '.' glyphs included
         if (current_rpm < 1000) {
             // Right justify with some margin
-            x_position = myOLEDwidth - text_width - 10;
-            if (x_position < 0) x_position = 0;
+            rpmScreen.setTextAlign(rpm_value_widget, SSD1306_graphics::alignRight, myOLEDwidth - 10);
+        } else {
+            rpmScreen.setTextAlign(rpm_value_widget, SSD1306_graphics::alignLeft, 0);
         }
-        
-        // Set cursor position and display the value
-        myOLED.setCursor(x_position, 0);
-        myOLED.print(buffer);
+        rpmScreen.setText(rpm_value_widget, buffer);
+        rpmScreen.setText(rpm_high_widget, "");
     } else {
-        // If over 10000, just display "HIGH"
-        myOLED.setFont(pFontDefault);
-        myOLED.setCursor(40, 20);
-        myOLED.print("HIGH RPM");
+        // If over 10000, just display "HIGH RPM", default font at 2x
+        rpmScreen.setText(rpm_value_widget, "");
+        rpmScreen.setText(rpm_high_widget, "HIGH RPM");
     }
     
-    myOLED.setFont(pFontDefault);
+    // Show surface speed after its label at the bottom
+    float surface_speed = calculate_surface_speed();
+    if (surface_speed < 10) {
+        FixedFormat::formatFixed(buffer, sizeof(buffer), FixedFormat::toFixed(surface_speed, 1), 0, 1); // One decimal place for small values
+    } else {
+        FixedFormat::formatFixed(buffer, sizeof(buffer), (int32_t)surface_speed, 0, 0); // Integer for larger values
+    }
+    rpmScreen.setText(rpm_status_widget, buffer);
+    
+    // History and bar draw in place, only their area is sent
+    int16_t graph_rpm = (current_rpm < 32767) ? (int16_t)current_rpm : 32767;
+    if (rpmHistory.addSample(graph_rpm)) {
+        const ClipRect& area = rpmHistory.bounds();
+        rpmScreen.addDamage(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
+    }
+    if (rpmBar.setValue(graph_rpm)) {
+        const ClipRect& area = rpmBar.bounds();
+        rpmScreen.addDamage(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
+    }
+}
+
+// Draw the static diameter and surface speed label of the RPM screen into the background
+void draw_rpm_background() {
+    FixedString<SSD1306_DisplayList::MaxTextLength> label;
+    label.append("D:").appendFixed(settings.workpiece_diameter, 2).append(settings.use_inches ? "\"" : "mm").append(" SFM:");
     
-    // Show surface speed in small font at bottom
-    myOLED.setCursor(1, 56);
+    myOLED.OLEDclearBuffer();
+    myOLED.setFont(pFontDefault);
+    myOLED.setTextScale(1);
+    myOLED.setInvertFont(false);
+    myOLED.drawText(1, 56, label);
+    myOLED.OLEDsaveBackground(backgroundBuffer);
     
-    // Show diameter and surface speed
-    myOLED.print("D:");
+    // Surface speed value follows the label
+    rpmScreen.setTextAlign(rpm_status_widget, SSD1306_graphics::alignLeft, 1 + myOLED.measureText(label));
+}
+
+// Bind the current RPM to the gauge needle and the RPM text, drawing the text is left to gaugeScreen.render()
+void display_gauge() {
+    FixedString<SSD1306_DisplayList::MaxTextLength> text;
+    text.appendNumber((int32_t)current_rpm).append(" RPM");
+    gaugeScreen.setText(gauge_value_widget, text.c_str());
     
-    if (settings.use_inches) {
-        myOLED.print(settings.workpiece_diameter);
-        myOLED.print("\" ");
-    } else {
-        myOLED.print(settings.workpiece_diameter);
-        myOLED.print("mm ");
+    // The needle moves in place, only the old and new needle area is sent
+    if (rpmGauge.setValue((int32_t)current_rpm)) {
+        const ClipRect& area = rpmGauge.damage();
+        gaugeScreen.addDamage(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
     }
-    
-    // Always show surface speed in SFM
-    myOLED.print("SFM:");
-    float surface_speed = calculate_surface_speed();
-    if (surface_speed < 10) {
-        myOLED.print(surface_speed, 1); // One decimal place for small values
-    } else {
-        myOLED.print((int)surface_speed); // Integer for larger values
+}
+
+// Draw the dial face and its scale labels into the background, the needle is drawn over it
+void draw_gauge_background() {
+    myOLED.OLEDclearBuffer();
+    myOLED.setFont(pFontDefault);
+    myOLED.setTextScale(1);
+    myOLED.setInvertFont(false);
+    rpmGauge.drawFace(GAUGE_DIVISIONS, 5);
+    for (uint8_t i = 0; i <= GAUGE_DIVISIONS; i++) {
+        const int32_t rpm = i * RPM_GRAPH_FULL_SCALE / GAUGE_DIVISIONS;
+        int16_t x, y;
+        rpmGauge.pointAt(rpm, 36, x, y);
+        myOLED.drawText(x, y - 4, FixedString<6>().appendNumber(rpm / 1000), SSD1306_graphics::alignCenter);
     }
+    myOLED.drawText(1, 0, "x1000");
+    myOLED.OLEDsaveBackground(backgroundBuffer);
 }
 
-// Display the settings menu
+// Write the settings menu into the console, only cells whose text changed are redrawn
 void display_menu() {
-    myOLED.setFont(pFontDefault);
+    FixedString<SSD1306_Console::Columns> line;
+    const uint8_t selected = current_menu - MENU_PULSES;
     
-    switch (current_menu) {
-        case MENU_PULSES:
-            myOLED.setCursor(0, 0);
-            myOLED.print("> Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("  Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("  Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("  Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("  Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("  Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-            
-        case MENU_RATIO:
-            myOLED.setCursor(0, 0);
-            myOLED.print("  Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("> Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("  Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("  Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("  Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("  Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-            
-        case MENU_DECIMAL:
-            myOLED.setCursor(0, 0);
-            myOLED.print("  Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("  Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("> Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("  Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("  Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("  Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-            
-        case MENU_FILTER:
-            myOLED.setCursor(0, 0);
-            myOLED.print("  Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("  Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("  Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("> Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("  Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("  Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-            
-        case MENU_DIAMETER:
-            myOLED.setCursor(0, 0);
-            myOLED.print("  Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("  Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("  Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("  Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("> Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("  Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-
-        case MENU_UNITS:
-            myOLED.setCursor(0, 0);
-            myOLED.print("  Pulses per rev: ");
-            myOLED.print(settings.pulses_per_rev);
-            myOLED.setCursor(0, 10);
-            myOLED.print("  Gear ratio: ");
-            myOLED.print(settings.gear_ratio, 1);
-            myOLED.setCursor(0, 20);
-            myOLED.print("  Show decimal: ");
-            myOLED.print(settings.show_decimal ? "Yes" : "No");
-            myOLED.setCursor(0, 30);
-            myOLED.print("  Filter: ");
-            myOLED.print(settings.filter_strength);
-            myOLED.setCursor(0, 40);
-            myOLED.print("  Diameter: ");
-            if (settings.use_inches) {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("\"");
-            } else {
-                myOLED.print(settings.workpiece_diameter);
-                myOLED.print("mm");
-            }
-            myOLED.setCursor(0, 50);
-            myOLED.print("> Units: ");
-            myOLED.print(settings.use_inches ? "Inches" : "Metric");
-            break;
-            
-        default:
-            break;
+    for (uint8_t row = 0; row < 7; row++) {
+        line.clear().append((row == selected) ? "> " : "  ").append(menu_captions[row]);
+        switch (row) {
+            case 0: line.appendNumber(settings.pulses_per_rev); break;
+            case 1: line.appendFixed(settings.gear_ratio, 1); break;
+            case 2: line.append(settings.show_decimal ? "Yes" : "No"); break;
+            case 3: line.appendNumber(settings.filter_strength); break;
+            case 4: line.appendFixed(settings.workpiece_diameter, 2).append(settings.use_inches ? "\"" : "mm"); break;
+            case 5: line.append(settings.use_inches ? "Inches" : "Metric"); break;
+            default: line.append((settings.display_mode == DISPLAY_GAUGE) ? "Gauge" : "Digits"); break;
+        }
+        menuConsole.printLine(row, line.c_str());
     }
 }
 
@@ -870,6 +1043,7 @@ void load_settings() {
         settings.filter_strength = 3; // Default medium filtering
         settings.workpiece_diameter = 25.0f; // Default 25mm (about 1 inch)
         settings.use_inches = false; // Default to metric
+        settings.display_mode = DISPLAY_DIGITS; // Default to the big digits
         
         // Save default settings
         save_settings();
@@ -878,8 +1052,10 @@ void load_settings() {
 
 // Save settings to flash
 void save_settings() {
-    printf("save_settings Called: use_inches=%d, workpiece_diameter=%.2f\n", 
-           settings.use_inches, settings.workpiece_diameter);
+    // Logged before interrupts go off, printed later by the main loop
+    const int32_t diameter = FixedFormat::toFixed(settings.workpiece_diameter, 2);
+    DeferredLog::log("save_settings Called: use_inches=%d, workpiece_diameter=%d.%02d\n", 
+           settings.use_inches, diameter / 100, diameter % 100);
 
     // Data must be a multiple of 256 bytes for flash operations
     uint8_t data[FLASH_PAGE_SIZE];
@@ -6,8 +6,11 @@
 */
 
 //#include <stdio.h> 
+#include <algorithm>
+#include <cstring>
 #include "pico/stdlib.h"
 #include "../../include/ssd1306/SSD1306_OLED.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_log.hpp"
 
 /*!
 	@brief init the screen object
@@ -80,13 +83,15 @@ DisplayRet::Ret_Codes_e SSD1306::OLEDSetBufferPtr(uint8_t width, uint8_t height
 {
 	if (buffer.size() != static_cast<size_t>(width * (height / 8)))
 	{
-		printf("SSD1306::OLEDSetBufferPtr Error 2: buffer size does not equal w * (h/8))\r\n");
+		DeferredLog::log("SSD1306::OLEDSetBufferPtr Error 2: buffer size does not equal w * (h/8))\r\n");
 		return DisplayRet::BufferSize;
 	}
 	_OLEDbuffer = buffer;
+	_page = SSD1306_PageBuffer(buffer, width, height);
+	_pageTarget = &_page;
 
 	if (buffer.empty())	{
-		printf("SSD1306::OLEDSetBufferPtr Error 3: Problem assigning buffer, received empty buffer\r\n");
+		DeferredLog::log("SSD1306::OLEDSetBufferPtr Error 3: Problem assigning buffer, received empty buffer\r\n");
 		return DisplayRet::BufferEmpty;
 	}
 	return DisplayRet::Success;
@@ -259,66 +264,186 @@ DisplayRet::Ret_Codes_e SSD1306::OLEDBitmap(int16_t x, int16_t y, int16_t w, int
 // 1. Completely out of bounds?
 if (x > _width || y > _height)
 {
-	printf("SSD1306::OLEDBitmap Error 1: Bitmap co-ord out of bounds, check x and y\r\n");
+	DeferredLog::log("SSD1306::OLEDBitmap Error 1: Bitmap co-ord out of bounds, check x and y\r\n");
 	return DisplayRet::BitmapScreenBounds;
 }
 // 2. bitmap weight and height
 if (w > _width || h > _height)
 {
-	printf("SSD1306::OLEDBitmap Error 2: Bitmap is larger than screen, check w and h\r\n");
+	DeferredLog::log("SSD1306::OLEDBitmap Error 2: Bitmap is larger than screen, check w and h\r\n");
 	return DisplayRet::BitmapLargerThanScreen;
 }
 // 3. bitmap is null
 if(pBitmap.empty()) 
 {
-	printf("SSD1306::OLEDBitmap Error 3: Bitmap is is not valid \n");
+	DeferredLog::log("SSD1306::OLEDBitmap Error 3: Bitmap is is not valid \n");
 	return DisplayRet::BitmapDataEmpty;
 }
 
 // 4. check Horizontal bitmap size
 if(w % 8 != 0 )
 {
-	printf("SSD1306::OLEDBitmap Error 4: Bitmap width size is incorrect: w %i h %i \n", w , h);
-	printf("Check is bitmap width divisible evenly by eight \n");
+	DeferredLog::log("SSD1306::OLEDBitmap Error 4: Bitmap width size is incorrect: w %i h %i \n", w , h);
+	DeferredLog::log("Check is bitmap width divisible evenly by eight \n");
 	return DisplayRet::BitmapHorizontalSize;
 }
 
 // 5. check  bitmap size
 if(pBitmap.size() != static_cast<size_t>((w / 8) * h))
 {
-	printf("SSD1306::OLEDBitmap Error 5: Bitmap size is incorrect: w %i h %i \n", w , h);
-	printf("Check bitmap size = ((w/8)*h)  \n");
+	DeferredLog::log("SSD1306::OLEDBitmap Error 5: Bitmap size is incorrect: w %i h %i \n", w , h);
+	DeferredLog::log("Check bitmap size = ((w/8)*h)  \n");
 	return DisplayRet::BitmapSize;
 }
 
 int16_t byteWidth = (w + 7) / 8; 
-uint8_t byte = 0;
-uint8_t color, bgcolor;
-if (invert == false)
+if (getRotation() != rDegrees_0)
 {
-	color = WHITE;
-	bgcolor = BLACK;
-}else
+	uint8_t byte = 0;
+	uint8_t color = invert ? BLACK : WHITE;
+	uint8_t bgcolor = invert ? WHITE : BLACK;
+	for (int16_t j = 0; j < h; j++, y++) 
+	{
+		for (int16_t i = 0; i < w; i++) 
+		{
+			if (i & 7)
+				byte <<= 1;
+			else
+				byte = pBitmap[j * byteWidth + i / 8];
+				
+			drawPixel(x + i, y, (byte & 0x80) ? color : bgcolor );
+		}
+	}
+	return DisplayRet::Success;
+}
+
+// Each 8x8 block of source bytes becomes eight buffer columns
+uint8_t rows[8];
+uint8_t cols[8];
+for (int16_t by = 0; by < h; by += 8)
 {
-	color = BLACK;
-	bgcolor = WHITE;
+	int16_t bandRows = std::min<int16_t>(8, h - by);
+	if ((y + by) >= _clip.y1 || (y + by + bandRows) <= _clip.y0) continue;
+	uint8_t mask = 0xFF >> (8 - bandRows);
+	for (int16_t bx = 0; bx < byteWidth; bx++)
+	{
+		int16_t x0 = x + (bx * 8);
+		if (x0 >= _clip.x1) break;
+		if ((x0 + 8) <= _clip.x0) continue;
+		for (int16_t k = 0; k < 8; k++)
+			rows[k] = (k < bandRows) ? pBitmap[(by + k) * byteWidth + bx] : 0x00;
+		transposeBlock(rows, cols);
+		for (uint8_t c = 0; c < 8; c++)
+			writeColumnBits(x0 + c, y + by, invert ? ~cols[c] : cols[c], mask);
+	}
+}
+return DisplayRet::Success;
+}
+
+/*!
+	@brief Draw a vertically addressed bitmap to the buffer
+	@param x x axis offset
+	@param y y axis offset
+	@param w width
+	@param h height
+	@param pBitmap span object to bitmap data
+	@param invert color 
+	@return Will return 
+		-# success
+		-# BitmapScreenBounds Bitmap co-ord out of bounds, check x and y
+		-# BitmapLargerThanScreen Bitmap is larger than screen, check w and h
+		-# BitmapEmpty Bitmap is an invalid object
+		-# BitmapVerticalSize Check vertical bitmap size
+		-# BitmapSize Check bitmap size
+	@note bitmap data must be vertically addressed (same layout as the buffer, 
+		one byte is 8 pixels down, LSB on top) and height divisible by 8.
+		Data is copied without conversion, any x and y are allowed.
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDBitmapVertical(int16_t x, int16_t y, int16_t w, int16_t h, std::span<const uint8_t> pBitmap, bool invert)
+{
+if (x > _width || y > _height)
+{
+	DeferredLog::log("SSD1306::OLEDBitmapVertical Error 1: Bitmap co-ord out of bounds, check x and y\r\n");
+	return DisplayRet::BitmapScreenBounds;
+}
+if (w > _width || h > _height)
+{
+	DeferredLog::log("SSD1306::OLEDBitmapVertical Error 2: Bitmap is larger than screen, check w and h\r\n");
+	return DisplayRet::BitmapLargerThanScreen;
+}
+if(pBitmap.empty()) 
+{
+	DeferredLog::log("SSD1306::OLEDBitmapVertical Error 3: Bitmap is is not valid \n");
+	return DisplayRet::BitmapDataEmpty;
+}
+if(h % 8 != 0 )
+{
+	DeferredLog::log("SSD1306::OLEDBitmapVertical Error 4: Bitmap height size is incorrect: w %i h %i \n", w , h);
+	DeferredLog::log("Check is bitmap height divisible evenly by eight \n");
+	return DisplayRet::BitmapVerticalSize;
+}
+if(pBitmap.size() != static_cast<size_t>(w * (h / 8)))
+{
+	DeferredLog::log("SSD1306::OLEDBitmapVertical Error 5: Bitmap size is incorrect: w %i h %i \n", w , h);
+	DeferredLog::log("Check bitmap size = (w*(h/8))  \n");
+	return DisplayRet::BitmapSize;
+}
+
+if (getRotation() != rDegrees_0)
+{
+	for (int16_t page = 0; page < h / 8; page++)
+		for (int16_t i = 0; i < w; i++)
+			SSD1306_graphics::drawColumnByte(x + i, y + (page * 8), pBitmap[(page * w) + i], invert);
+	return DisplayRet::Success;
 }
 
-for (int16_t j = 0; j < h; j++, y++) 
+int16_t first = std::max<int16_t>(0, _clip.x0 - x);
+int16_t last = std::min<int16_t>(w, _clip.x1 - x);
+for (int16_t page = 0; page < h / 8; page++)
 {
-	for (int16_t i = 0; i < w; i++) 
+	int16_t py = y + (page * 8);
+	const uint8_t* src = &pBitmap[page * w];
+	if ((py & 7) == 0 && py >= _clip.y0 && (py + 8) <= _clip.y1)
 	{
-		if (i & 7)
-			byte <<= 1;
-		else
-			byte = pBitmap[j * byteWidth + i / 8];
-			
-		drawPixel(x + i, y, (byte & 0x80) ? color : bgcolor );
+		// page aligned, straight copy
+		uint8_t* row = _page.pageRow(py);
+		for (int16_t i = first; i < last; i++)
+			row[x + i] = invert ? ~src[i] : src[i];
+	} else
+	{
+		for (int16_t i = first; i < last; i++)
+			writeColumnBits(x + i, py, invert ? ~src[i] : src[i], 0xFF);
 	}
 }
 return DisplayRet::Success;
 }
 
+/*!
+	@brief Transpose an 8x8 bit block from row bytes to column bytes
+	@param rows eight row bytes, MSB is the left pixel
+	@param cols eight column bytes, LSB is the top pixel
+	@note Three swap stages on two 32 bit words (Hacker's Delight transpose8),
+		no per pixel branches. Rows are loaded bottom up so the result lands
+		with the top row in bit 0.
+*/
+void SSD1306::transposeBlock(const uint8_t rows[8], uint8_t cols[8])
+{
+	uint32_t x = (static_cast<uint32_t>(rows[7]) << 24) | (rows[6] << 16) | (rows[5] << 8) | rows[4];
+	uint32_t y = (static_cast<uint32_t>(rows[3]) << 24) | (rows[2] << 16) | (rows[1] << 8) | rows[0];
+	uint32_t t;
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+	t = (x ^ (x >> 14)) & 0x0000CCCC; x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC; y = y ^ t ^ (t << 14);
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	cols[0] = x >> 24; cols[1] = x >> 16; cols[2] = x >> 8; cols[3] = x;
+	cols[4] = y >> 24; cols[5] = y >> 16; cols[6] = y >> 8; cols[7] = y;
+}
+
 /*!
 	@brief Writes a byte to I2C address,command or data, used internally
 	@param value write the value to be written
@@ -338,8 +463,7 @@ void SSD1306::I2CWriteByte(uint8_t value, uint8_t cmd)
 	{ // failure to write I2C byte 
 		if (_bSerialDebugFlag)
 		{
-			printf("SSD1306::I2C_Write_Byte : Cannot Write byte : Retry Attempt = %u\n", attemptI2Cwrite);
-			printf("Error code %i\n", returnCode);
+			DeferredLog::log("SSD1306::I2C_Write_Byte : Cannot Write byte : Retry Attempt = %u, Error code %i\n", attemptI2Cwrite, returnCode);
 		}
 		if (attemptI2Cwrite >= _I2CRetryAttempts) break;
 		returnCode = i2c_write_timeout_us(_i2c, _OLEDAddressI2C, dataBuffer, 2 , false, _TimeoutDelayI2C);
@@ -352,6 +476,35 @@ void SSD1306::I2CWriteByte(uint8_t value, uint8_t cmd)
 		_bIsConnected = true;
 }
 
+/*!
+	@brief Writes a run of display data bytes in one I2C transaction, used internally
+	@param data bytes to send
+	@param length number of bytes, at most SSD1306_DATA_BURST_MAX
+	@note Retries as I2CWriteByte does.
+*/
+void SSD1306::I2CWriteData(const uint8_t* data, uint8_t length)
+{
+	uint8_t dataBuffer[SSD1306_DATA_BURST_MAX + 1];
+	if (length > SSD1306_DATA_BURST_MAX) length = SSD1306_DATA_BURST_MAX;
+	dataBuffer[0] = SSD1306_DATA_CONTINUE;
+	memcpy(&dataBuffer[1], data, length);
+	uint8_t attemptI2Cwrite = 0;
+	int16_t returnCode = i2c_write_timeout_us(_i2c, _OLEDAddressI2C, dataBuffer, length + 1, false, _TimeoutDelayI2C);
+
+	while(returnCode < 1)
+	{ // failure to write I2C data
+		if (_bSerialDebugFlag)
+		{
+			DeferredLog::log("SSD1306::I2CWriteData : Cannot Write data : Retry Attempt = %u, Error code %i\n", attemptI2Cwrite, returnCode);
+		}
+		if (attemptI2Cwrite >= _I2CRetryAttempts) break;
+		returnCode = i2c_write_timeout_us(_i2c, _OLEDAddressI2C, dataBuffer, length + 1, false, _TimeoutDelayI2C);
+		busy_wait_ms(_I2CRetryDelay); // mS
+		attemptI2Cwrite ++;
+	}
+	_bIsConnected = (returnCode >= 1);
+}
+
 /*!
 	@brief updates the buffer i.e. writes it to the screen
 */
@@ -359,7 +512,7 @@ DisplayRet::Ret_Codes_e SSD1306::OLEDupdate()
 {
 	if (_OLEDbuffer.empty())
 	{
-		printf("SSD1306::OLEDupdate Error: Buffer is empty, cannot update screen\r\n");
+		DeferredLog::log("SSD1306::OLEDupdate Error: Buffer is empty, cannot update screen\r\n");
 		return DisplayRet::BufferEmpty;
 	}
 	uint8_t x = 0;
@@ -371,6 +524,258 @@ DisplayRet::Ret_Codes_e SSD1306::OLEDupdate()
 	return DisplayRet::Success;
 }
 
+/*!
+	@brief Writes part of the buffer to the screen
+	@param x x co-ordinate of the region, current rotation
+	@param y y co-ordinate of the region, current rotation
+	@param w width of the region
+	@param h height of the region
+	@return Will return
+		-# Success, also when the region is off screen
+		-# BufferEmpty
+	@note The region is widened to whole pages, an address window is set to
+		it and each page row goes out as one burst I2C write. A one digit
+		change then costs its own columns rather than a full frame.
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDupdateRegion(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	if (_OLEDbuffer.empty())
+	{
+		DeferredLog::log("SSD1306::OLEDupdateRegion Error: Buffer is empty, cannot update screen\r\n");
+		return DisplayRet::BufferEmpty;
+	}
+	ClipRect region = bufferRegion(x, y, w, h);
+	if (region.x1 <= region.x0 || region.y1 <= region.y0) return DisplayRet::Success;
+	const int16_t col0 = region.x0;
+	const int16_t col1 = region.x1 - 1;
+	const int16_t page0 = region.y0 / 8;
+	const int16_t page1 = (region.y1 - 1) / 8;
+
+	I2CWriteByte( SSD1306_SET_COLUMN_ADDR );
+	I2CWriteByte( col0 );
+	I2CWriteByte( col1 );
+	I2CWriteByte( SSD1306_SET_PAGE_ADDR );
+	I2CWriteByte( page0 );
+	I2CWriteByte( page1 );
+	for (int16_t page = page0; page <= page1; page++)
+	{
+		I2CWriteData(&_OLEDbuffer[(_OLED_WIDTH * page) + col0], col1 - col0 + 1);
+	}
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Convert a region in rotated screen co-ordinates to buffer co-ordinates
+	@param x x co-ordinate of the region
+	@param y y co-ordinate of the region
+	@param w width of the region
+	@param h height of the region
+	@return region clipped to the buffer, x1 and y1 exclusive, empty if off screen
+*/
+ClipRect SSD1306::bufferRegion(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	int16_t bx = x, by = y, bw = w, bh = h;
+	switch (getRotation()) {
+	case rDegrees_90:
+		bx = WIDTH - (y + h); by = x; bw = h; bh = w;
+	break;
+	case rDegrees_180:
+		bx = WIDTH - (x + w); by = HEIGHT - (y + h);
+	break;
+	case rDegrees_270:
+		bx = y; by = HEIGHT - (x + w); bw = h; bh = w;
+	break;
+	default: break;
+	}
+	ClipRect region;
+	region.x0 = std::max<int16_t>(bx, 0);
+	region.y0 = std::max<int16_t>(by, 0);
+	region.x1 = std::min<int16_t>(bx + bw, _OLED_WIDTH);
+	region.y1 = std::min<int16_t>(by + bh, _OLED_HEIGHT);
+	if (region.x1 <= region.x0 || region.y1 <= region.y0) return ClipRect{};
+	return region;
+}
+
+/*!
+	@brief Copy the buffer into a background layer, e.g. after drawing the static labels of a screen
+	@param layer background layer, same size as the buffer
+	@return Success, BufferEmpty or BufferSize
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDsaveBackground(std::span<uint8_t> layer)
+{
+	if (_OLEDbuffer.empty())
+	{
+		DeferredLog::log("SSD1306::OLEDsaveBackground Error: Buffer is empty\r\n");
+		return DisplayRet::BufferEmpty;
+	}
+	if (layer.size() != _OLEDbuffer.size())
+	{
+		DeferredLog::log("SSD1306::OLEDsaveBackground Error: layer is %u bytes, buffer %u\r\n",
+			static_cast<unsigned>(layer.size()), static_cast<unsigned>(_OLEDbuffer.size()));
+		return DisplayRet::BufferSize;
+	}
+	std::memcpy(layer.data(), _OLEDbuffer.data(), layer.size());
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Start a frame from a background layer instead of a cleared buffer, i.e. does NOT write to the screen
+	@param layer background layer saved by OLEDsaveBackground
+	@return Success, BufferEmpty or BufferSize
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDrestoreBackground(std::span<const uint8_t> layer)
+{
+	if (_OLEDbuffer.empty())
+	{
+		DeferredLog::log("SSD1306::OLEDrestoreBackground Error: Buffer is empty\r\n");
+		return DisplayRet::BufferEmpty;
+	}
+	if (layer.size() != _OLEDbuffer.size())
+	{
+		DeferredLog::log("SSD1306::OLEDrestoreBackground Error: layer is %u bytes, buffer %u\r\n",
+			static_cast<unsigned>(layer.size()), static_cast<unsigned>(_OLEDbuffer.size()));
+		return DisplayRet::BufferSize;
+	}
+	std::memcpy(_OLEDbuffer.data(), layer.data(), layer.size());
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Move a region of the buffer left, the columns uncovered on the right are cleared
+	@param x x co-ordinate of the region
+	@param y y co-ordinate of the region, multiple of 8
+	@param w width of the region
+	@param h height of the region, multiple of 8
+	@param columns columns to move by
+	@return Success, BufferEmpty or RegionUnaligned
+	@note One memmove per page, for scrolling charts without redrawing them.
+		Rotation 0 only, other rotations return RegionUnaligned so the caller
+		can redraw instead.
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDscrollRegionLeft(int16_t x, int16_t y, int16_t w, int16_t h, int16_t columns)
+{
+	if (_OLEDbuffer.empty())
+	{
+		DeferredLog::log("SSD1306::OLEDscrollRegionLeft Error: Buffer is empty\r\n");
+		return DisplayRet::BufferEmpty;
+	}
+	if (getRotation() != rDegrees_0 || (y & 7) || (h & 7) || x < 0 || y < 0 || w <= 0 || h <= 0
+		|| (x + w) > _OLED_WIDTH || (y + h) > _OLED_HEIGHT)
+	{
+		return DisplayRet::RegionUnaligned;
+	}
+	columns = std::clamp<int16_t>(columns, 0, w);
+	for (int16_t page = y / 8; page < (y + h) / 8; page++)
+	{
+		uint8_t* row = &_OLEDbuffer[(_OLED_WIDTH * page) + x];
+		std::memmove(row, row + columns, w - columns);
+		std::memset(row + w - columns, 0x00, columns);
+	}
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Copy one region of a background layer back into the buffer
+	@param layer background layer saved by OLEDsaveBackground
+	@param x x co-ordinate of the region
+	@param y y co-ordinate of the region
+	@param w width of the region
+	@param h height of the region
+	@return Success, BufferEmpty or BufferSize
+	@note Whole pages are copied with memcpy, the rows of a partly covered page are merged with a mask.
+*/
+DisplayRet::Ret_Codes_e SSD1306::OLEDrestoreRegion(std::span<const uint8_t> layer, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	if (_OLEDbuffer.empty() || layer.size() != _OLEDbuffer.size())
+	{
+		DeferredLog::log("SSD1306::OLEDrestoreRegion Error: Buffer is empty or layer size is wrong\r\n");
+		return _OLEDbuffer.empty() ? DisplayRet::BufferEmpty : DisplayRet::BufferSize;
+	}
+	ClipRect region = bufferRegion(x, y, w, h);
+	if (region.x1 <= region.x0 || region.y1 <= region.y0) return DisplayRet::Success;
+	const int16_t columns = region.x1 - region.x0;
+	for (int16_t page = region.y0 / 8; page <= (region.y1 - 1) / 8; page++)
+	{
+		const int16_t top = std::max<int16_t>(region.y0 - (page * 8), 0);
+		const int16_t bottom = std::min<int16_t>(region.y1 - (page * 8), 8);
+		const uint8_t mask = (0xFF << top) & (0xFF >> (8 - bottom));
+		const size_t offset = (_OLED_WIDTH * page) + region.x0;
+		if (mask == 0xFF)
+		{
+			std::memcpy(&_OLEDbuffer[offset], &layer[offset], columns);
+			continue;
+		}
+		for (int16_t col = 0; col < columns; col++)
+			_OLEDbuffer[offset + col] = (_OLEDbuffer[offset + col] & ~mask) | (layer[offset + col] & mask);
+	}
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Point drawing at one page strip, used internally by OLEDupdateStrips
+	@param strip strip buffer, at least screen width bytes
+	@param page page the strip holds
+	@return Success or BufferSize
+*/
+DisplayRet::Ret_Codes_e SSD1306::beginStrip(std::span<uint8_t> strip, uint8_t page)
+{
+	if (strip.size() < _OLED_WIDTH)
+	{
+		DeferredLog::log("SSD1306::OLEDupdateStrips Error: strip is %u bytes, needs %u\r\n",
+			static_cast<unsigned>(strip.size()), _OLED_WIDTH);
+		endStrips();
+		return DisplayRet::BufferSize;
+	}
+	std::fill(strip.begin(), strip.begin() + _OLED_WIDTH, 0x00);
+	_page = SSD1306_PageBuffer(strip.first(_OLED_WIDTH), _OLED_WIDTH, 8, page * 8);
+	_pageTarget = &_page;
+
+	// the page's rows in rotated co-ordinates
+	const int16_t row0 = page * 8;
+	switch (getRotation()) {
+	case rDegrees_90:
+		_drawable = ClipRect{row0, 0, static_cast<int16_t>(row0 + 8), _height};
+	break;
+	case rDegrees_180:
+		_drawable = ClipRect{0, static_cast<int16_t>(HEIGHT - row0 - 8), _width, static_cast<int16_t>(HEIGHT - row0)};
+	break;
+	case rDegrees_270:
+		_drawable = ClipRect{static_cast<int16_t>(HEIGHT - row0 - 8), 0, static_cast<int16_t>(HEIGHT - row0), _height};
+	break;
+	default:
+		_drawable = ClipRect{0, row0, _width, static_cast<int16_t>(row0 + 8)};
+	break;
+	}
+	resetClip();
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Send the strip to its page, used internally by OLEDupdateStrips
+	@param page page the strip holds
+*/
+void SSD1306::sendStrip(uint8_t page)
+{
+	I2CWriteByte( SSD1306_SET_COLUMN_ADDR );
+	I2CWriteByte( 0 );
+	I2CWriteByte( _OLED_WIDTH - 1 );
+	I2CWriteByte( SSD1306_SET_PAGE_ADDR );
+	I2CWriteByte( page );
+	I2CWriteByte( page );
+	I2CWriteData(_page.pageRow(page * 8), _OLED_WIDTH);
+}
+
+/*!
+	@brief Point drawing back at the full buffer, used internally by OLEDupdateStrips
+*/
+void SSD1306::endStrips(void)
+{
+	_page = SSD1306_PageBuffer(_OLEDbuffer, _OLED_WIDTH, _OLED_HEIGHT);
+	_pageTarget = &_page;
+	_drawable = ClipRect{0, 0, _width, _height};
+	resetClip();
+}
+
 /*!
 	@brief clears the buffer memory i.e. does NOT write to the screen
 */
@@ -378,7 +783,7 @@ DisplayRet::Ret_Codes_e SSD1306::OLEDclearBuffer()
 {
 	if (_OLEDbuffer.empty())
 	{
-		printf("SSD1306::OLEDclearBuffer Error: Buffer is empty, cannot clear\r\n");
+		DeferredLog::log("SSD1306::OLEDclearBuffer Error: Buffer is empty, cannot clear\r\n");
 		return DisplayRet::BufferEmpty;
 	}
 
@@ -437,7 +842,7 @@ void SSD1306::OLEDBuffer(int16_t x, int16_t y, uint8_t w, uint8_t h, std::span<u
 void SSD1306::drawPixel(int16_t x, int16_t y, uint8_t color)
 {
 
-	if ((x < 0) || (x >= this->_width) || (y < 0) || (y >= this->_height)) {
+	if ((x < _clip.x0) || (x >= _clip.x1) || (y < _clip.y0) || (y >= _clip.y1)) {
 	return;
 	}
 	int16_t temp;
@@ -458,13 +863,45 @@ void SSD1306::drawPixel(int16_t x, int16_t y, uint8_t color)
 		y = HEIGHT - 1 - temp;
 	break;
 	}
-		uint16_t tc = (_OLED_WIDTH * (y /8)) + x;
-		switch (color)
-		{
-			case WHITE:  this->_OLEDbuffer[tc] |= (1 << (y & 7)); break;
-			case BLACK:  this->_OLEDbuffer[tc] &= ~(1 << (y & 7)); break;
-			case INVERSE: this->_OLEDbuffer[tc] ^= (1 << (y & 7)); break;
-		}
+	_page.plot(x, y, color);
+}
+
+/*!
+	@brief Draws 8 vertically stacked pixels straight into the buffer, overides the gfx lib version
+	@param x x axis position
+	@param y y axis position of the top pixel, need not be page aligned
+	@param data pixel data, bit 0 is the top pixel
+	@param invert false set bits are WHITE, true set bits are BLACK
+	@note An unaligned y touches two page bytes with one masked write each.
+		Rotated screens fall back to the pixel by pixel version.
+*/
+void SSD1306::drawColumnByte(int16_t x, int16_t y, uint8_t data, bool invert)
+{
+	if (getRotation() != rDegrees_0) {
+		SSD1306_graphics::drawColumnByte(x, y, data, invert);
+		return;
+	}
+	writeColumnBits(x, y, invert ? ~data : data, 0xFF);
+}
+
+/*!
+	@brief Write the masked bits of an 8 pixel column into the buffer, rotation 0 only
+	@param x The x coordinate
+	@param y The y coordinate of bit 0, may be negative or not page aligned
+	@param data column pixels, LSB on top
+	@param mask bits of data to write, other pixels keep their value
+	@note The column covers at most two pages, each byte is cleared with
+		AND then set with OR. Rows outside the clip rectangle are masked off.
+*/
+void SSD1306::writeColumnBits(int16_t x, int16_t y, uint8_t data, uint8_t mask)
+{
+	if ((x < _clip.x0) || (x >= _clip.x1) || (y <= (_clip.y0 - 8)) || (y >= _clip.y1)) {
+		return;
+	}
+	// drop the rows above and below the clip rectangle
+	if (y < _clip.y0) mask &= 0xFF << (_clip.y0 - y);
+	if ((y + 8) > _clip.y1) mask &= 0xFF >> ((y + 8) - _clip.y1);
+	_page.writeColumn(x, y, data, mask);
 }
 
 /*!
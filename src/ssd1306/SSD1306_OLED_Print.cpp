@@ -6,6 +6,7 @@
 
 
 #include "../../include/ssd1306/SSD1306_OLED_Print.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_format.hpp"
 
 // Public Methods //////////////////////////
 
@@ -124,11 +125,11 @@ size_t Print::println(double num, int digits)
   return n;
 }
 
-size_t Print::print(const std::string &s) {
-    return write(s.c_str(), s.length());
+size_t Print::print(std::string_view s) {
+    return write(s.data(), s.length());
 }
 
-size_t Print::println(const std::string &s) {
+size_t Print::println(std::string_view s) {
     size_t n = print(s);
     n += println();
     return n;
@@ -164,6 +165,7 @@ size_t Print::printFloat(double number, uint8_t digits)
   if (std::isinf(number)) return print("inf");
   if (number > 4294967040.0) return print ("ovf");  // constant determined empirically
   if (number <-4294967040.0) return print ("ovf");  // constant determined empirically
+  if (digits > FixedFormat::MaxDecimals) digits = FixedFormat::MaxDecimals;
   
   // Handle negative numbers
   if (number < 0.0)
@@ -172,31 +174,36 @@ size_t Print::printFloat(double number, uint8_t digits)
      number = -number;
   }
 
-  // Round correctly so that print(1.999, 2) prints as "2.00"
-  double rounding = 0.5;
+  // Scale once and round correctly so that print(1.999, 2) prints as "2.00",
+  // the digits are then written with integer division only
+  uint32_t scale = 1;
   for (uint8_t i=0; i<digits; ++i)
-    rounding /= 10.0;
-  
-  number += rounding;
+    scale *= 10;
+  char buf[FixedFormat::MaxLength + 1];
+
+  double scaled = number * scale + 0.5;
+  if (scaled < 2147483648.0)
+  {
+    FixedFormat::formatFixed(buf, sizeof(buf), (int32_t)scaled, 0, digits);
+    return n + write(buf);
+  }
 
-  // Extract the integer part of the number and print it
+  // Too large for one 32 bit value, the integer and fraction parts separately
   unsigned long int_part = (unsigned long)number;
-  double remainder = number - (double)int_part;
-  n += print(int_part);
+  uint32_t fraction = (uint32_t)((number - (double)int_part) * scale + 0.5);
+  if (fraction >= scale)
+  {
+    int_part++;
+    fraction -= scale;
+  }
+  n += printNumber(int_part, 10);
 
   // Print the decimal point, but only if there are digits beyond
   if (digits > 0) {
     n += print('.'); 
+    FixedFormat::formatFixed(buf, sizeof(buf), (int32_t)fraction, digits, 0, FixedFormat::AlignZero);
+    n += write(buf);
   }
-
-  // Extract digits from the remainder one at a time
-  while (digits-- > 0)
-  {
-    remainder *= 10.0;
-    unsigned int toPrint = (unsigned int)(remainder);
-    n += print(toPrint);
-    remainder -= toPrint; 
-  } 
   
   return n;
 }
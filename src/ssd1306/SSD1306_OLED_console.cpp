@@ -0,0 +1,168 @@
+/*!
+* @file SSD1306_OLED_console.cpp
+* @brief OLED driven by SSD1306 controller. Character cell console source file
+* @details <https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO>
+*/
+
+#include "../../include/ssd1306/SSD1306_OLED_console.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_font.hpp"
+
+/*!
+	@brief init the console, every cell a blank space
+	@param display display the cells are drawn on and flushed to
+*/
+SSD1306_Console::SSD1306_Console(SSD1306& display) : _display(display)
+{
+}
+
+/*!
+	@brief Set every cell to a blank space, only cells not already blank become dirty
+*/
+void SSD1306_Console::clear(void)
+{
+	for (uint8_t row = 0; row < Rows; row++)
+		for (uint8_t column = 0; column < Columns; column++)
+			setCell(column, row, ' ');
+}
+
+/*!
+	@brief Mark every cell dirty, e.g. after the buffer was cleared or drawn over
+*/
+void SSD1306_Console::invalidate(void)
+{
+	_dirty.fill((1UL << Columns) - 1);
+}
+
+/*!
+	@brief Write one cell, marked dirty only when its content changes
+	@param column cell column 0-20
+	@param row cell row 0-7
+	@param value character
+	@param attr CellAttr_e bits
+	@note Cells outside the grid are ignored.
+*/
+void SSD1306_Console::setCell(uint8_t column, uint8_t row, char value, uint8_t attr)
+{
+	if (column >= Columns || row >= Rows) return;
+	Cell_t& cell = _cells[row][column];
+	if (cell.value == value && cell.attr == attr) return;
+	cell.value = value;
+	cell.attr = attr;
+	_dirty[row] |= (1UL << column);
+}
+
+/*!
+	@brief Write text into a row from a column, no wrapping
+	@param column first cell column
+	@param row cell row
+	@param text text, cut at the end of the row
+	@param attr CellAttr_e bits
+	@return column after the last cell written
+*/
+uint8_t SSD1306_Console::printAt(uint8_t column, uint8_t row, const char* text, uint8_t attr)
+{
+	if (text == nullptr) return column;
+	while (*text != '\0' && column < Columns)
+		setCell(column++, row, *text++, attr);
+	return column;
+}
+
+/*!
+	@brief Replace a whole row, cells after the text are blanked
+	@param row cell row
+	@param text text, cut at the end of the row
+	@param attr CellAttr_e bits
+*/
+void SSD1306_Console::printLine(uint8_t row, const char* text, uint8_t attr)
+{
+	uint8_t column = printAt(0, row, text, attr);
+	while (column < Columns)
+		setCell(column++, row, ' ', attr);
+}
+
+/*!
+	@brief Character of a cell
+	@param column cell column
+	@param row cell row
+	@return character, space for cells outside the grid
+*/
+char SSD1306_Console::getChar(uint8_t column, uint8_t row) const
+{
+	if (column >= Columns || row >= Rows) return ' ';
+	return _cells[row][column].value;
+}
+
+/*!
+	@brief true if a cell changed since the last render
+	@param column cell column
+	@param row cell row
+*/
+bool SSD1306_Console::isDirty(uint8_t column, uint8_t row) const
+{
+	if (column >= Columns || row >= Rows) return false;
+	return (_dirty[row] >> column) & 1;
+}
+
+/*!
+	@brief Draw the dirty cells into the buffer
+	@return number of cells drawn
+	@note Sets the default font, text scale 1 and leaves the invert font
+		setting as the last cell set it. Expects rotation 0 or 180.
+*/
+uint8_t SSD1306_Console::render(void)
+{
+	uint8_t drawn = 0;
+	_display.setFont(pFontDefault);
+	_display.setTextScale(1);
+	for (uint8_t row = 0; row < Rows; row++)
+	{
+		uint32_t dirty = _dirty[row];
+		for (uint8_t column = 0; dirty != 0; column++, dirty >>= 1)
+		{
+			if (!(dirty & 1)) continue;
+			const Cell_t& cell = _cells[row][column];
+			const int16_t x = column * CellWidth;
+			const int16_t y = row * CellHeight;
+			const bool invert = cell.attr & AttrInvert;
+			_display.fillRect(x, y, CellWidth, CellHeight, invert ? SSD1306::WHITE : SSD1306::BLACK);
+			if (cell.value != ' ')
+			{
+				_display.setInvertFont(invert);
+				_display.writeChar(x, y, cell.value);
+			}
+			drawn++;
+		}
+		_unsent[row] |= _dirty[row];
+		_dirty[row] = 0;
+	}
+	return drawn;
+}
+
+/*!
+	@brief Send the rendered cells to the screen, one page span per run of cells in a row
+*/
+void SSD1306_Console::flush(void)
+{
+	for (uint8_t row = 0; row < Rows; row++)
+	{
+		uint32_t unsent = _unsent[row];
+		uint8_t column = 0;
+		while (unsent != 0)
+		{
+			if (!(unsent & 1))
+			{
+				unsent >>= 1;
+				column++;
+				continue;
+			}
+			const uint8_t first = column;
+			while (unsent & 1)
+			{
+				unsent >>= 1;
+				column++;
+			}
+			_display.OLEDupdateRegion(first * CellWidth, row * CellHeight, (column - first) * CellWidth, CellHeight);
+		}
+		_unsent[row] = 0;
+	}
+}
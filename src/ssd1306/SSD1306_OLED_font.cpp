@@ -7,12 +7,14 @@
 */
 
 #include "../../include/ssd1306/SSD1306_OLED_font.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_font_tools.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_log.hpp"
 
 /*! 
     Standard ASCII 6x8 font 
     Full Ascii Range 0-0xFF 
 */
-static const std::array<uint8_t, 1534> FontDefault = 
+static constexpr std::array<uint8_t, 1534> FontDefault = 
 { 
 0x06, 0x08, 0x00, 0xFF, // x_size, y_size, offset, total characters,
 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,   
@@ -276,7 +278,7 @@ static const std::array<uint8_t, 1534> FontDefault =
     wide font 9 by 8 (one padding)
     NO lowercase letters, font ends at 'Z'
 */
-static const std::array<uint8_t, 535> FontWide  = 
+static constexpr std::array<uint8_t, 535> FontWide  = 
 {
 0x09, 0x08, 0x20, 0x3A, // x_size, y_size, offset, total characters,
 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, //  
@@ -345,7 +347,7 @@ static const std::array<uint8_t, 535> FontWide  =
     Font size: 32x48 pixels
     This is a clear reading sixteen-segment font with some special symbols / . - :
 */
-static const std::array<uint8_t, 2692> FontSixteenSeg = 
+static constexpr std::array<uint8_t, 2692> FontSixteenSeg = 
 {
 0x20,0x30,0x2D,0x0D,  // x-size, y-size, offset, total characters
 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x80,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0x80,0x00,0x00,0x80,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0xC0,0x80,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x01,0x00,0x00,0x01,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x03,0x01,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,  // -
@@ -364,15 +366,48 @@ static const std::array<uint8_t, 2692> FontSixteenSeg =
 0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x60,0xF0,0xF0,0x60,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x06,0x0E,0x0E,0x06,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,  // :
 };
 
+/*!
+    FontSixteenSeg run length encoded at compile time, see SSD1306_OLED_font_tools.hpp
+*/
+static constexpr auto FontSixteenSegRLE =
+    FontTools::rleEncodeFont<FontTools::rleFontSize(FontSixteenSeg)>(FontSixteenSeg);
+
+/*!
+    FontSixteenSeg proportional (narrow 1 . : -) and run length encoded at compile time,
+    4 pixel gap between glyphs
+*/
+static constexpr uint8_t SixteenSegPropFlags =
+    SSD1306_OLEDFonts::FontFormatRLE | SSD1306_OLEDFonts::FontFormatProportional;
+static constexpr auto FontSixteenSegProp =
+    FontTools::convertFont<FontTools::convertedFontSize(FontSixteenSeg, SixteenSegPropFlags, 4)>(
+        FontSixteenSeg, SixteenSegPropFlags, 4);
+
+#ifdef SSD1306_FONT_SUBSET
+#include "SSD1306_OLED_charset.hpp"
+/*!
+    FontDefault cut down at compile time to the characters the firmware prints,
+    FontCharset is generated by the build, see cmake/FontCharset.cmake
+*/
+static constexpr auto FontDefaultSubset =
+    FontTools::subsetFont<FontTools::subsetFontSize(FontDefault, FontCharset)>(FontDefault, FontCharset);
+const std::span<const uint8_t> pFontDefault = FontDefaultSubset;
+#else
 const std::span<const uint8_t> pFontDefault = FontDefault;
+#endif
 const std::span<const uint8_t> pFontWide = FontWide;
 const std::span<const uint8_t> pFontSixteenSeg =  FontSixteenSeg;
+const std::span<const uint8_t> pFontSixteenSegRLE = FontSixteenSegRLE;
+const std::span<const uint8_t> pFontSixteenSegProp = FontSixteenSegProp;
 
 // === Font class implementation ===
 /*!
 	@brief init the OLED  font class object constructor
+	@note Selects pFontDefault, which may be a subset font in the extended format
  */
-SSD1306_OLEDFonts::SSD1306_OLEDFonts(){};
+SSD1306_OLEDFonts::SSD1306_OLEDFonts()
+{
+	setFont(pFontDefault);
+}
 
 /*!
 	@brief SSD1306_SetFont
@@ -381,28 +416,182 @@ SSD1306_OLEDFonts::SSD1306_OLEDFonts(){};
 		-# Success
 		-# FontDataEmpty
 		-# FontDataTooSmall
+		-# FontFormatInvalid
+		-# FontHeightUnaligned raw font height is not a multiple of 8
+	@note Glyphs are always drawn as page column bytes. A raw font with a
+		height that is not a multiple of 8 (bit stream glyphs) must be page
+		aligned first, see FontTools::pageAlignFont and setFont(font, scratch).
  */
 DisplayRet::Ret_Codes_e SSD1306_OLEDFonts::setFont(std::span<const uint8_t> SelectedFontName) {
 	if (SelectedFontName.empty())
 	{
-		printf("SSD1306_OLEDFonts::setFont Error: Font data is empty\n");
+		DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Font data is empty\n");
 		return DisplayRet::FontDataEmpty;
 	}
 
 	if (SelectedFontName.size() < 5) {  // Ensure the font data has at least 4 bytes
-		printf("SSD1306_OLEDFonts::setFont Error: Font data too small\n");
+		DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Font data too small\n");
 		return DisplayRet::FontDataTooSmall;
 	}
 
+	if (SelectedFontName[0] == 0x00) // extended header, byte 1 holds the format flags
+	{
+		const uint8_t knownFlags = FontFormatRLE | FontFormatProportional | FontFormatSparse;
+		if (SelectedFontName.size() < FontTools::ExtHeaderSize ||
+			(SelectedFontName[1] & ~knownFlags) != 0 || SelectedFontName[3] == 0)
+		{
+			DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Unknown font format\n");
+			return DisplayRet::FontFormatInvalid;
+		}
+		// sparse character list and glyph table, the last glyph index is _FontNumChars
+		uint16_t glyphs = SelectedFontName[5] + 1;
+		uint16_t indexStart = FontTools::ExtHeaderSize + ((SelectedFontName[1] & FontFormatSparse) ? glyphs : 0);
+		uint16_t indexSize = FontTools::glyphEntrySize(SelectedFontName[1]) * glyphs;
+		if (SelectedFontName.size() <= indexStart + indexSize)
+		{
+			DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Font glyph index truncated\n");
+			return DisplayRet::FontFormatInvalid;
+		}
+		_FontSelect   = SelectedFontName;
+		_FontFormat   = SelectedFontName[1];
+		_Font_X_Size  = SelectedFontName[2];
+		_Font_Y_Size  = SelectedFontName[3];
+		_FontOffset   = SelectedFontName[4];
+		_FontNumChars = SelectedFontName[5];
+		_FontIndexStart = indexStart;
+		_FontDataStart = indexStart + indexSize;
+		_FontInverted = false;
+		return DisplayRet::Success;
+	}
+
+	if ((SelectedFontName[1] % 8) != 0)
+	{
+		DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Font height %u is not page aligned\n", SelectedFontName[1]);
+		return DisplayRet::FontHeightUnaligned;
+	}
 	_FontSelect   = SelectedFontName;
+	_FontFormat   = FontFormatRaw;
 	_Font_X_Size  = SelectedFontName[0];
 	_Font_Y_Size  = SelectedFontName[1];
 	_FontOffset   = SelectedFontName[2];
 	_FontNumChars = SelectedFontName[3];
+	_FontDataStart = FontTools::RawHeaderSize;
 	_FontInverted = false;
 	return DisplayRet::Success;
 }
 
+/*!
+	@brief Select a raw font, page aligning it into a buffer first if its height is not a multiple of 8
+	@param SelectedFontName font, any layout setFont takes plus raw bit stream fonts
+	@param scratch RAM the page aligned font is written to, kept by the caller
+		while the font is in use, FontTools::pageAlignedFontSize bytes
+	@return Will return
+		-# Success
+		-# FontScratchTooSmall
+		-# any setFont(font) error
+	@note Fonts that need no conversion are selected as they are and scratch
+		is not touched. The conversion runs once here, so every glyph is
+		then drawn with the column byte blitter.
+ */
+DisplayRet::Ret_Codes_e SSD1306_OLEDFonts::setFont(std::span<const uint8_t> SelectedFontName, std::span<uint8_t> scratch)
+{
+	if (SelectedFontName.size() < 5 || SelectedFontName[0] == 0x00 || (SelectedFontName[1] % 8) == 0)
+		return setFont(SelectedFontName);
+
+	const size_t alignedSize = FontTools::pageAlignedFontSize(SelectedFontName);
+	if (scratch.size() < alignedSize)
+	{
+		DeferredLog::log("SSD1306_OLEDFonts::setFont Error: Scratch buffer %u bytes, page aligned font needs %u\n",
+			static_cast<unsigned>(scratch.size()), static_cast<unsigned>(alignedSize));
+		return DisplayRet::FontScratchTooSmall;
+	}
+	FontTools::writeFont(SelectedFontName, FontFormatRaw, 0, scratch.data());
+	return setFont(scratch.first(alignedSize));
+}
+
+/*!
+	@brief Map a character to its glyph number in the active font
+	@param value character
+	@return glyph number, -1 if the character is outside the font range or left out of a sparse font
+*/
+int16_t SSD1306_OLEDFonts::glyphIndex(char value)
+{
+	if (_FontFormat & FontFormatSparse)
+	{
+		// binary search of the ascending character list
+		const uint8_t wanted = static_cast<uint8_t>(value);
+		uint16_t low = 0;
+		uint16_t high = _FontNumChars + 1;
+		while (low < high)
+		{
+			uint16_t mid = (low + high) / 2;
+			if (_FontSelect[FontTools::ExtHeaderSize + mid] < wanted)
+				low = mid + 1;
+			else
+				high = mid;
+		}
+		if (low <= _FontNumChars && _FontSelect[FontTools::ExtHeaderSize + low] == wanted)
+			return low;
+		return -1;
+	}
+	if (value < _FontOffset || value >= (_FontOffset + _FontNumChars + 1))
+		return -1;
+	return value - _FontOffset;
+}
+
+/*!
+	@brief Find the first data byte of a glyph in the active font
+	@param glyphIndex glyph number, character minus the font offset
+	@return index into _FontSelect
+*/
+uint16_t SSD1306_OLEDFonts::glyphStart(uint8_t glyphIndex)
+{
+	if (_FontFormat & FontFormatProportional)
+	{
+		uint16_t entry = _FontIndexStart + (4 * glyphIndex) + 2;
+		return _FontDataStart + (_FontSelect[entry] | (_FontSelect[entry + 1] << 8));
+	}
+	if (_FontFormat & FontFormatRLE)
+	{
+		uint16_t entry = _FontIndexStart + (2 * glyphIndex);
+		return _FontDataStart + (_FontSelect[entry] | (_FontSelect[entry + 1] << 8));
+	}
+	return _FontDataStart + (glyphIndex * (_Font_X_Size * glyphPages()));
+}
+
+/*!
+	@brief Number of pages (8 pixel row bands) stored per glyph column in the active font
+	@return font height divided by 8, rounded up, the last page is padded
+*/
+uint8_t SSD1306_OLEDFonts::glyphPages(void)
+{
+	return (_Font_Y_Size + 7) / 8;
+}
+
+/*!
+	@brief Number of pixel columns stored for a glyph in the active font
+	@param glyphIndex glyph number, character minus the font offset
+	@return glyph width, _Font_X_Size for fixed width fonts
+*/
+uint8_t SSD1306_OLEDFonts::glyphWidth(uint8_t glyphIndex)
+{
+	if (_FontFormat & FontFormatProportional)
+		return _FontSelect[_FontIndexStart + (4 * glyphIndex) + 1];
+	return _Font_X_Size;
+}
+
+/*!
+	@brief Cursor advance of a glyph in the active font
+	@param glyphIndex glyph number, character minus the font offset
+	@return advance in pixels, _Font_X_Size for fixed width fonts
+*/
+uint8_t SSD1306_OLEDFonts::glyphAdvance(uint8_t glyphIndex)
+{
+	if (_FontFormat & FontFormatProportional)
+		return _FontSelect[_FontIndexStart + (4 * glyphIndex)];
+	return _Font_X_Size;
+}
+
 /*!
 	@brief setInvertFont
 	@param invertStatus set the invert status flag of font ,false = off. 
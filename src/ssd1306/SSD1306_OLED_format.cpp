@@ -0,0 +1,86 @@
+/*!
+* @file SSD1306_OLED_format.cpp
+* @brief OLED driven by SSD1306 controller. Fixed point number formatting source file
+* @details <https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO>
+*/
+
+#include <cmath>
+#include <limits>
+#include "../../include/ssd1306/SSD1306_OLED_format.hpp"
+
+namespace FixedFormat
+{
+
+/*! @brief 10 to the power of the table index, the scale of each decimals setting */
+static constexpr uint32_t Pow10[MaxDecimals + 1] =
+	{1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+
+/*!
+	@brief Write a scaled integer as decimal text
+	@param buffer destination, always zero terminated if size is not 0
+	@param size size of buffer including the terminator
+	@param value number times 10 to the power of decimals, e.g. 1234 for 123.4 with one decimal
+	@param width minimum field width, shorter numbers are padded, 0 for none
+	@param decimals digits after the decimal point, 0 for none, at most MaxDecimals
+	@param align placement inside the field, see Align_e
+	@return characters written without the terminator, 0 and an empty
+		string if the field does not fit in buffer
+	@note A fraction always gets a leading zero, 5 with two decimals is "0.05".
+		Only unsigned division by 10 is used.
+*/
+size_t formatFixed(char* buffer, size_t size, int32_t value, uint8_t width, uint8_t decimals, Align_e align)
+{
+	if (decimals > MaxDecimals) decimals = MaxDecimals;
+	char digits[MaxDecimals + 2];
+	uint8_t count = 0;
+	uint32_t magnitude = (value < 0) ? 0u - static_cast<uint32_t>(value) : value;
+	do {
+		digits[count++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude > 0 || count <= decimals);
+
+	const size_t length = (value < 0) + count + (decimals > 0);
+	const size_t field = (width > length) ? width : length;
+	if (field + 1 > size)
+	{
+		if (size > 0) buffer[0] = '\0';
+		return 0;
+	}
+
+	size_t pad = field - length;
+	size_t pos = 0;
+	if (align == AlignRight)
+		while (pad > 0) { buffer[pos++] = ' '; pad--; }
+	if (value < 0) buffer[pos++] = '-';
+	if (align == AlignZero)
+		while (pad > 0) { buffer[pos++] = '0'; pad--; }
+	while (count > 0)
+	{
+		if (count == decimals) buffer[pos++] = '.';
+		buffer[pos++] = digits[--count];
+	}
+	while (pad > 0) { buffer[pos++] = ' '; pad--; }
+	buffer[pos] = '\0';
+	return pos;
+}
+
+/*!
+	@brief Scale and round a float to a fixed point value for formatFixed
+	@param value number
+	@param decimals digits after the decimal point, at most MaxDecimals
+	@return value times 10 to the power of decimals, rounded half away from
+		zero, clamped to the int32_t range, 0 for nan
+	@note One float multiply and conversion, the per digit work is left to
+		formatFixed.
+*/
+int32_t toFixed(float value, uint8_t decimals)
+{
+	if (decimals > MaxDecimals) decimals = MaxDecimals;
+	if (std::isnan(value)) return 0;
+	const float scaled = value * static_cast<float>(Pow10[decimals]);
+	if (scaled >= 2147483520.0f) return std::numeric_limits<int32_t>::max(); // largest float below 2^31
+	if (scaled <= -2147483648.0f) return std::numeric_limits<int32_t>::min();
+	return static_cast<int32_t>((scaled < 0.0f) ? scaled - 0.5f : scaled + 0.5f);
+}
+
+} // namespace FixedFormat
@@ -5,9 +5,14 @@
 * @details https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO
 */
 
+#include <algorithm>
+#include <cstring>
 #include "../../include/ssd1306/SSD1306_OLED_graphics.hpp"
 #include "../../include/ssd1306/SSD1306_OLED_font.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_font_tools.hpp"
 #include "../../include/ssd1306/SSD1306_OLED.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_raster.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_log.hpp"
 
 
 // === Graphics class implementation ===
@@ -22,11 +27,46 @@ SSD1306_graphics::SSD1306_graphics(int16_t w, int16_t h):
 {
 	_width    = WIDTH;
 	_height   = HEIGHT;
+	_clip     = ClipRect{0, 0, WIDTH, HEIGHT};
+	_drawable = _clip;
 	_cursor_y  = 0; 
 	_cursor_x  = 0;
 	_textwrap  = true;
 }
 
+/*!
+	@brief Raster target that draws through the virtual drawPixel, used for
+		rotated screens and sub-classes without a page buffer.
+*/
+struct PixelTarget {
+	SSD1306_graphics& gfx; /**< display drawn to */
+	inline void plot(int16_t x, int16_t y, uint8_t color) { gfx.drawPixel(x, y, color); }
+	inline void vspan(int16_t x, int16_t y0, int16_t y1, uint8_t color) {
+		for (int16_t y = y0; y <= y1; y++) gfx.drawPixel(x, y, color);
+	}
+	inline void hspan(int16_t x0, int16_t x1, int16_t y, uint8_t color) {
+		for (int16_t x = x0; x <= x1; x++) gfx.drawPixel(x, y, color);
+	}
+};
+
+/*!
+	@brief Run a raster algorithm on the fastest target available
+	@param fn generic callable taking the target by reference
+	@note At rotation 0 with a page buffer the algorithm is instantiated for
+		SSD1306_PageBuffer and writes the buffer directly, otherwise every
+		pixel goes through drawPixel.
+*/
+template <class Fn>
+void SSD1306_graphics::render(Fn fn)
+{
+	if (_pageTarget != nullptr && _display_rotate == rDegrees_0 && _pageTarget->valid()) {
+		fn(*_pageTarget);
+	} else {
+		PixelTarget target{*this};
+		fn(target);
+	}
+}
+
 /*!
 	@brief Write 1 character on OLED.
 	@param  x character starting position on x-axis.
@@ -38,72 +78,178 @@ SSD1306_graphics::SSD1306_graphics(int16_t w, int16_t h):
 		-# CharFontASCIIRange Character out of ASCII Font bounds, check Font range
  */
 DisplayRet::Ret_Codes_e SSD1306_graphics::writeChar(int16_t x, int16_t y, char value) {
-	uint16_t fontIndex = 0;
-	uint16_t rowCount = 0;
-	uint16_t count = 0;
-	uint8_t colIndex;
-	uint16_t temp = 0;
-	int16_t colByte, cx, cy;
-	int16_t colbit;
-	
 	// 1. Check for screen out of  bounds
 	if((x >= _width)            || // Clip right
 	(y >= _height)           || // Clip bottom
-	((x + _Font_X_Size+1) < 0) || // Clip left
-	((y + _Font_Y_Size) < 0))   // Clip top
+	((x + (_Font_X_Size * _textScale)+1) < 0) || // Clip left
+	((y + (_Font_Y_Size * _textScale)) < 0))   // Clip top
 	{
-		printf("SSD1306_graphics::writeChar Error 2: Co-ordinates out of bounds \r\n");
+		DeferredLog::log("SSD1306_graphics::writeChar Error 2: Co-ordinates out of bounds \r\n");
 		return DisplayRet::CharScreenBounds;
 	}
 	// 2. Check for character out of font range bounds
-	if ( value < _FontOffset || value >= (_FontOffset + _FontNumChars + 1))
+	int16_t glyph = glyphIndex(value);
+	if (glyph < 0)
 	{
-		printf("SSD1306_graphics::writeChar Error 3: Character out of Font bounds  %c : %u<->%u \r\n", value  ,_FontOffset, _FontOffset + _FontNumChars);
+		DeferredLog::log("SSD1306_graphics::writeChar Error 3: Character out of Font bounds  %c : %u<->%u \r\n", value  ,_FontOffset, _FontOffset + _FontNumChars);
 		return DisplayRet::CharFontASCIIRange;
 	}
-	if (_Font_Y_Size % 8 == 0) // Is the font height divisible by 8
+	// 3. Skip characters wholly outside the clip rectangle, partial ones are clipped per column
+	if (_clip.rejects(x, y, std::max<int16_t>(glyphAdvance(glyph), _Font_X_Size) * _textScale, _Font_Y_Size * _textScale))
+	{
+		return DisplayRet::Success;
+	}
+	// the last page of a glyph is padded, rows below the font height are clipped off
+	const ClipRect clip = _clip;
+	_clip.y1 = std::min<int16_t>(_clip.y1, y + (_Font_Y_Size * _textScale));
+	drawGlyph(x, y, glyph);
+	_clip = clip;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Draw one glyph of the active font, used internally by writeChar and drawText
+	@param x character starting position on x-axis.
+	@param y character starting position on y-axis.
+	@param glyph glyph number from glyphIndex
+	@note Expects the clip rectangle already cut to the font height.
+ */
+void SSD1306_graphics::drawGlyph(int16_t x, int16_t y, int16_t glyph)
+{
+	uint16_t fontIndex = 0;
+	uint16_t rowCount = 0;
+	uint16_t count = 0;
+	uint8_t glyphCols = glyphWidth(glyph);
+	uint8_t glyphRows = glyphPages();
+	if (_FontFormat & FontFormatRLE)
 	{
-		fontIndex = ((value - _FontOffset)*(_Font_X_Size * (_Font_Y_Size/ 8))) + 4;
-		for (rowCount = 0; rowCount < (_Font_Y_Size / 8); rowCount++) 
+		drawGlyphRLE(x, y, glyphStart(glyph), glyphCols, getInvertFont());
+	} else
+	{
+		fontIndex = glyphStart(glyph);
+		for (rowCount = 0; rowCount < glyphRows; rowCount++) 
 		{
-			for (count = 0; count < _Font_X_Size; count++) 
+			for (count = 0; count < glyphCols; count++) 
 			{
-				//temp = *(_FontSelect + fontIndex + count + (rowCount * _Font_X_Size));
-				temp = _FontSelect[fontIndex + count + (rowCount * _Font_X_Size)];
-				for (colIndex = 0; colIndex < 8; colIndex++) 
-				{
-					if (temp & (1 << colIndex)) {
-							drawPixel(x + count, y + (rowCount * 8) + colIndex, !getInvertFont());
-					} else {
-							drawPixel(x + count, y + (rowCount * 8) + colIndex, getInvertFont());
-					}
-				}
+				drawGlyphByte(x, y, count, rowCount,
+					_FontSelect[fontIndex + count + (rowCount * glyphCols)], getInvertFont());
 			}
 		}
-	} else 
+	}
+	// proportional glyphs fill the gap up to their advance with background
+	for (count = glyphCols; count < glyphAdvance(glyph); count++)
+	{
+		for (rowCount = 0; rowCount < glyphRows; rowCount++)
+			drawGlyphByte(x, y, count, rowCount, 0x00, getInvertFont());
+	}
+}
+
+/*!
+	@brief Decode a run length encoded glyph straight into the display, used internally by writeChar
+	@param x character starting position on x-axis.
+	@param y character starting position on y-axis.
+	@param fontIndex index in _FontSelect of the glyph's first run
+	@param glyphCols number of columns stored for the glyph
+	@param invert font inverted flag
+	@note Runs are decoded in raw page order, column by column, no glyph sized buffer is needed.
+ */
+void SSD1306_graphics::drawGlyphRLE(int16_t x, int16_t y, uint16_t fontIndex, uint8_t glyphCols, bool invert)
+{
+	uint16_t remaining = glyphCols * glyphPages();
+	uint8_t col = 0;
+	uint8_t page = 0;
+	while (remaining > 0)
 	{
-		fontIndex = ((value - _FontOffset)*((_Font_X_Size * _Font_Y_Size) / 8)) + 4;
-		colByte = _FontSelect[fontIndex];
-		colbit = 7;
-		for (cx = 0; cx < _Font_X_Size; cx++) 
+		uint8_t control = _FontSelect[fontIndex++];
+		uint8_t tag = control & FontTools::RunTagMask;
+		uint8_t run = (control & ~FontTools::RunTagMask) + 1;
+		uint8_t data = 0x00;
+		if (tag == FontTools::RunRepeat) data = _FontSelect[fontIndex++];
+		if (run > remaining) run = remaining; // corrupt stream, stay inside the glyph
+		remaining -= run;
+		while (run--)
 		{
-			for (cy = 0; cy < _Font_Y_Size; cy++) 
+			if (tag == FontTools::RunLiteral) data = _FontSelect[fontIndex++];
+			drawGlyphByte(x, y, col, page, data, invert);
+			if (++col == glyphCols)
 			{
-				if ((colByte & (1 << colbit)) != 0) {
-					drawPixel(x + cx, y + cy, !getInvertFont());
-				} else {
-					drawPixel(x + cx, y + cy, getInvertFont());
-				}
-				colbit--;
-				if (colbit < 0) {
-					colbit = 7;
-					fontIndex++;
-					colByte = _FontSelect[fontIndex];
-				}
+				col = 0;
+				page++;
 			}
 		}
 	}
-	return DisplayRet::Success;
+}
+
+/*!
+	@brief Bit expansion tables for scaled text, one per scale 2 to 4.
+	@details Entry n holds nibble n with every bit repeated scale times,
+		so a font byte expands to scale page bytes with two lookups.
+*/
+static constexpr std::array<std::array<uint16_t, 16>, 3> NibbleExpand = []() {
+	std::array<std::array<uint16_t, 16>, 3> table{};
+	for (uint8_t scale = 2; scale <= 4; scale++)
+	{
+		for (uint8_t nibble = 0; nibble < 16; nibble++)
+		{
+			uint16_t bits = 0;
+			for (uint8_t bit = 0; bit < 4; bit++)
+				if (nibble & (1 << bit))
+					bits |= ((1 << scale) - 1) << (bit * scale);
+			table[scale - 2][nibble] = bits;
+		}
+	}
+	return table;
+}();
+
+/*!
+	@brief Draw one column byte of a glyph at the current text scale, used internally by writeChar
+	@param x character starting position on x-axis.
+	@param y character starting position on y-axis.
+	@param col glyph column of the byte
+	@param page glyph page (8 pixel row band) of the byte
+	@param data glyph column byte
+	@param invert font inverted flag
+	@note A scaled byte is expanded with NibbleExpand into scale page bytes,
+		each written scale times side by side.
+ */
+void SSD1306_graphics::drawGlyphByte(int16_t x, int16_t y, uint8_t col, uint8_t page, uint8_t data, bool invert)
+{
+	if (_textScale == 1)
+	{
+		drawColumnByte(x + col, y + (page * 8), data, invert);
+		return;
+	}
+	const std::array<uint16_t, 16>& table = NibbleExpand[_textScale - 2];
+	uint32_t expanded = table[data & 0x0F] | (static_cast<uint32_t>(table[data >> 4]) << (4 * _textScale));
+	int16_t cx = x + (col * _textScale);
+	int16_t cy = y + (page * 8 * _textScale);
+	for (uint8_t band = 0; band < _textScale; band++)
+	{
+		uint8_t bandByte = (expanded >> (8 * band)) & 0xFF;
+		for (uint8_t dx = 0; dx < _textScale; dx++)
+			drawColumnByte(cx + dx, cy + (band * 8), bandByte, invert);
+	}
+}
+
+/*!
+	@brief Draw 8 vertically stacked pixels, bit 0 is the top pixel.
+	@param x column position
+	@param y position of the top pixel, need not be page aligned
+	@param data pixel data, set bits are drawn foreground, clear bits background
+	@param invert swap foreground and background
+	@note Default pixel by pixel version, the OLED class overrides this
+		with a write straight into the page buffer.
+ */
+void SSD1306_graphics::drawColumnByte(int16_t x, int16_t y, uint8_t data, bool invert)
+{
+	for (uint8_t bit = 0; bit < 8; bit++)
+	{
+		if (data & (1 << bit)) {
+			drawPixel(x, y + bit, !invert);
+		} else {
+			drawPixel(x, y + bit, invert);
+		}
+	}
 }
 
 /*!
@@ -117,7 +263,7 @@ DisplayRet::Ret_Codes_e SSD1306_graphics::writeChar(int16_t x, int16_t y, char v
 		-# Failure in writeChar method upstream, that error code will be returned
  */
 DisplayRet::Ret_Codes_e SSD1306_graphics::writeCharString(int16_t x, int16_t y, char * pText) {
-	uint8_t count=0;
+	int16_t cursor = x;
 	uint8_t MaxLength=0;
 	// Check for null pointer
 	if(pText == nullptr)
@@ -128,22 +274,135 @@ DisplayRet::Ret_Codes_e SSD1306_graphics::writeCharString(int16_t x, int16_t y,
 	DisplayRet::Ret_Codes_e DrawCharReturnCode;
 	while(*pText != '\0')
 	{
+		uint8_t advance = measureChar(*pText);
 		// check if text has reached end of screen
-		if ((x + (count * _Font_X_Size)) > _width - _Font_X_Size)
+		if (cursor > _width - advance)
 		{
-			y = y + _Font_Y_Size;
-			x = 0;
-			count = 0;
+			y = y + (_Font_Y_Size * _textScale);
+			cursor = 0;
 		}
-		DrawCharReturnCode = writeChar(x + (count * (_Font_X_Size)), y, *pText++);
+		DrawCharReturnCode = writeChar(cursor, y, *pText++);
 		if(DrawCharReturnCode  != DisplayRet::Success) return DrawCharReturnCode;
-		count++;
+		cursor += advance;
 		MaxLength++;
 		if (MaxLength >= 200) break; // 2nd way out of loop, safety check
 	}
 	return DisplayRet::Success;
 }
 
+/*!
+	@brief Write Text character array on OLED, aligned against an anchor point.
+	@param  x anchor on x-axis, left edge, centre or right edge of the text
+	@param  y character starting position on y-axis.
+	@param  pText Pointer to the array of the text to be written.
+	@param  align which part of the text sits on the anchor
+	@return Will return
+		-# 0 Success
+		-# CharArrayNullptr  String pText Array invalid pointer object
+		-# Failure in writeChar method upstream, that error code will be returned
+	@note The text is not wrapped.
+ */
+DisplayRet::Ret_Codes_e SSD1306_graphics::writeCharStringAligned(int16_t x, int16_t y, const char * pText, text_align_e align) {
+	if(pText == nullptr)
+	{
+		return DisplayRet::CharArrayNullptr;
+	}
+	switch (align)
+	{
+		case alignLeft: break;
+		case alignCenter: x -= measureString(pText) / 2; break;
+		case alignRight: x -= measureString(pText); break;
+	}
+	DisplayRet::Ret_Codes_e DrawCharReturnCode;
+	while(*pText != '\0')
+	{
+		DrawCharReturnCode = writeChar(x, y, *pText);
+		if(DrawCharReturnCode  != DisplayRet::Success) return DrawCharReturnCode;
+		x += measureChar(*pText++);
+	}
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Draw a run of text in one call, aligned against an anchor point.
+	@param  x anchor on x-axis, left edge, centre or right edge of the text
+	@param  y character starting position on y-axis.
+	@param  text the characters, need not be zero terminated
+	@param  align which part of the text sits on the anchor
+	@return Will return
+		-# 0 Success
+		-# CharFontASCIIRange a character is not in the font, the text after it is not drawn
+	@note Not wrapped, glyphs outside the screen or clip rectangle are
+		skipped without an error. Each glyph is looked up once and the clip
+		is cut to the font height once for the whole run, there is no
+		virtual call or cursor update per character.
+ */
+DisplayRet::Ret_Codes_e SSD1306_graphics::drawText(int16_t x, int16_t y, std::string_view text, text_align_e align) {
+	switch (align)
+	{
+		case alignLeft: break;
+		case alignCenter: x -= measureText(text) / 2; break;
+		case alignRight: x -= measureText(text); break;
+	}
+	const int16_t cellWidth = _Font_X_Size * _textScale;
+	const int16_t cellHeight = _Font_Y_Size * _textScale;
+	const ClipRect clip = _clip;
+	_clip.y1 = std::min<int16_t>(_clip.y1, y + cellHeight);
+	DisplayRet::Ret_Codes_e result = DisplayRet::Success;
+	for (char value : text)
+	{
+		if (x >= _clip.x1) break; // the rest of the run is right of the clip
+		int16_t glyph = glyphIndex(value);
+		if (glyph < 0)
+		{
+			DeferredLog::log("SSD1306_graphics::drawText Error: Character out of Font bounds  %c : %u<->%u \r\n", value, _FontOffset, _FontOffset + _FontNumChars);
+			result = DisplayRet::CharFontASCIIRange;
+			break;
+		}
+		const int16_t advance = glyphAdvance(glyph) * _textScale;
+		if (!_clip.rejects(x, y, std::max(advance, cellWidth), cellHeight))
+			drawGlyph(x, y, glyph);
+		x += advance;
+	}
+	_clip = clip;
+	return result;
+}
+
+/*!
+	@brief Width a character occupies in the active font, the cursor advance
+	@param  value the character
+	@return advance in pixels at the current text scale, 0 if the character is not in the font
+ */
+uint8_t SSD1306_graphics::measureChar(char value) {
+	int16_t glyph = glyphIndex(value);
+	if (glyph < 0) return 0;
+	return glyphAdvance(glyph) * _textScale;
+}
+
+/*!
+	@brief Width of a text in the active font
+	@param  pText Pointer to the array of the text to be measured.
+	@return sum of the character advances in pixels
+ */
+int16_t SSD1306_graphics::measureString(const char * pText) {
+	if (pText == nullptr) return 0;
+	return measureText(pText);
+}
+
+/*!
+	@brief Width of a run of text in the active font
+	@param  text the characters, need not be zero terminated
+	@return sum of the character advances in pixels
+ */
+int16_t SSD1306_graphics::measureText(std::string_view text) {
+	int16_t width = 0;
+	for (char value : text)
+	{
+		width += measureChar(value);
+	}
+	return width;
+}
+
 /*! 
 	@brief write method used in the print class when user calls print
 	@param character the character to print
@@ -158,7 +417,7 @@ size_t SSD1306_graphics::write(uint8_t character)
 	switch (character)
 	{
 		case '\n': 
-			_cursor_y += _Font_Y_Size;
+			_cursor_y += (_Font_Y_Size * _textScale);
 			_cursor_x  = 0;
 		break;
 		case '\r': break;
@@ -170,10 +429,10 @@ size_t SSD1306_graphics::write(uint8_t character)
 				setWriteError(DrawCharReturnCode); // Set error flag to non-zero value}
 				break;
 			}
-			_cursor_x += (_Font_X_Size);
-			if (_textwrap && (_cursor_x  > (_width - (_Font_X_Size)))) 
+			_cursor_x += measureChar(character);
+			if (_textwrap && (_cursor_x  > (_width - (_Font_X_Size * _textScale)))) 
 			{
-				_cursor_y += _Font_Y_Size;
+				_cursor_y += (_Font_Y_Size * _textScale);
 				_cursor_x = 0;
 			}
 		break;
@@ -191,36 +450,7 @@ size_t SSD1306_graphics::write(uint8_t character)
 */
 void SSD1306_graphics::drawCircle(int16_t x0, int16_t y0, int16_t r,
 	uint8_t color) {
-	int16_t f = 1 - r;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * r;
-	int16_t x = 0;
-	int16_t y = r;
-
-	drawPixel(x0  , y0+r, color);
-	drawPixel(x0  , y0-r, color);
-	drawPixel(x0+r, y0  , color);
-	drawPixel(x0-r, y0  , color);
-
-	while (x<y) {
-	if (f >= 0) {
-		y--;
-		ddF_y += 2;
-		f += ddF_y;
-	}
-	x++;
-	ddF_x += 2;
-	f += ddF_x;
-	
-	drawPixel(x0 + x, y0 + y, color);
-	drawPixel(x0 - x, y0 + y, color);
-	drawPixel(x0 + x, y0 - y, color);
-	drawPixel(x0 - x, y0 - y, color);
-	drawPixel(x0 + y, y0 + x, color);
-	drawPixel(x0 - y, y0 + x, color);
-	drawPixel(x0 + y, y0 - x, color);
-	drawPixel(x0 - y, y0 - x, color);
-	}
+	render([&](auto& t) { Raster::circle(t, _clip, x0, y0, r, color); });
 }
 
 /*!
@@ -228,38 +458,7 @@ void SSD1306_graphics::drawCircle(int16_t x0, int16_t y0, int16_t r,
 */
 void SSD1306_graphics::drawCircleHelper( int16_t x0, int16_t y0,
 				 int16_t r, uint8_t cornername, uint8_t color) {
-	int16_t f     = 1 - r;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * r;
-	int16_t x     = 0;
-	int16_t y     = r;
-
-	while (x<y) {
-	if (f >= 0) {
-		y--;
-		ddF_y += 2;
-		f     += ddF_y;
-	}
-	x++;
-	ddF_x += 2;
-	f     += ddF_x;
-	if (cornername & 0x4) {
-		drawPixel(x0 + x, y0 + y, color);
-		drawPixel(x0 + y, y0 + x, color);
-	} 
-	if (cornername & 0x2) {
-		drawPixel(x0 + x, y0 - y, color);
-		drawPixel(x0 + y, y0 - x, color);
-	}
-	if (cornername & 0x8) {
-		drawPixel(x0 - y, y0 + x, color);
-		drawPixel(x0 - x, y0 + y, color);
-	}
-	if (cornername & 0x1) {
-		drawPixel(x0 - y, y0 - x, color);
-		drawPixel(x0 - x, y0 - y, color);
-	}
-	}
+	render([&](auto& t) { Raster::circleCorners(t, _clip, x0, y0, r, cornername, color); });
 }
 
 /*!
@@ -271,8 +470,11 @@ void SSD1306_graphics::drawCircleHelper( int16_t x0, int16_t y0,
 */
 void SSD1306_graphics::fillCircle(int16_t x0, int16_t y0, int16_t r,
 					uint8_t color) {
-	drawFastVLine(x0, y0-r, 2*r+1, color);
-	fillCircleHelper(x0, y0, r, 3, 0, color);
+	if (_clip.rejects(x0 - abs(r), y0 - abs(r), 2 * abs(r) + 1, 2 * abs(r) + 1)) return;
+	render([&](auto& t) {
+		Raster::fastVLine(t, _clip, x0, y0-r, 2*r+1, color);
+		Raster::fillCircleHalves(t, _clip, x0, y0, r, 3, 0, color);
+	});
 }
 
 /*!
@@ -280,32 +482,7 @@ void SSD1306_graphics::fillCircle(int16_t x0, int16_t y0, int16_t r,
 */
 void SSD1306_graphics::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 	uint8_t cornername, int16_t delta, uint8_t color) {
-
-	int16_t f     = 1 - r;
-	int16_t ddF_x = 1;
-	int16_t ddF_y = -2 * r;
-	int16_t x     = 0;
-	int16_t y     = r;
-
-	while (x<y) {
-	if (f >= 0) {
-		y--;
-		ddF_y += 2;
-		f     += ddF_y;
-	}
-	x++;
-	ddF_x += 2;
-	f     += ddF_x;
-
-	if (cornername & 0x1) {
-		drawFastVLine(x0+x, y0-y, 2*y+1+delta, color);
-		drawFastVLine(x0+y, y0-x, 2*x+1+delta, color);
-	}
-	if (cornername & 0x2) {
-		drawFastVLine(x0-x, y0-y, 2*y+1+delta, color);
-		drawFastVLine(x0-y, y0-x, 2*x+1+delta, color);
-	}
-	}
+	render([&](auto& t) { Raster::fillCircleHalves(t, _clip, x0, y0, r, cornername, delta, color); });
 }
 
 /*!
@@ -319,42 +496,7 @@ void SSD1306_graphics::fillCircleHelper(int16_t x0, int16_t y0, int16_t r,
 void SSD1306_graphics::drawLine(int16_t x0, int16_t y0,
 				int16_t x1, int16_t y1,
 				uint8_t color) {
-	int16_t steep = abs(y1 - y0) > abs(x1 - x0);
-	if (steep) {
-	swapInt16_OLED(x0, y0);
-	swapInt16_OLED(x1, y1);
-	}
-
-	if (x0 > x1) {
-	swapInt16_OLED(x0, x1);
-	swapInt16_OLED(y0, y1);
-	}
-
-	int16_t dx, dy;
-	dx = x1 - x0;
-	dy = abs(y1 - y0);
-
-	int16_t err = dx / 2;
-	int16_t ystep;
-
-	if (y0 < y1) {
-	ystep = 1;
-	} else {
-	ystep = -1;
-	}
-
-	for (; x0<=x1; x0++) {
-	if (steep) {
-		drawPixel(y0, x0, color);
-	} else {
-		drawPixel(x0, y0, color);
-	}
-	err -= dy;
-	if (err < 0) {
-		y0 += ystep;
-		err += dx;
-	}
-	}
+	render([&](auto& t) { Raster::line(t, _clip, x0, y0, x1, y1, color); });
 }
 
 /*!
@@ -384,7 +526,7 @@ void SSD1306_graphics::drawRect(int16_t x, int16_t y,
 */
 void SSD1306_graphics::drawFastVLine(int16_t x, int16_t y,
 				 int16_t h, uint8_t color) {
-	drawLine(x, y, x, y+h-1, color);
+	render([&](auto& t) { Raster::fastVLine(t, _clip, x, y, h, color); });
 }
 
 /*!
@@ -396,7 +538,7 @@ void SSD1306_graphics::drawFastVLine(int16_t x, int16_t y,
 */
 void SSD1306_graphics::drawFastHLine(int16_t x, int16_t y,
 				 int16_t w, uint8_t color) {
-		drawLine(x, y, x+w-1, y, color);
+	render([&](auto& t) { Raster::fastHLine(t, _clip, x, y, w, color); });
 }
 
 /*!
@@ -409,9 +551,7 @@ void SSD1306_graphics::drawFastHLine(int16_t x, int16_t y,
 */
 void SSD1306_graphics::fillRect(int16_t x, int16_t y, int16_t w, int16_t h,
 				uint8_t color) {
-	for (int16_t i=x; i<x+w; i++) {
-	drawFastVLine(i, y, h, color);
-	}
+	render([&](auto& t) { Raster::fillRect(t, _clip, x, y, w, h, color); });
 }
 
 /*!
@@ -455,12 +595,18 @@ void SSD1306_graphics::drawRoundRect(int16_t x, int16_t y, int16_t w,
 */
 void SSD1306_graphics::fillRoundRect(int16_t x, int16_t y, int16_t w,
 				 int16_t h, int16_t r, uint8_t color) {
-	// smarter version
-	fillRect(x+r, y, w-2*r, h, color);
-
-	// draw four corners
-	fillCircleHelper(x+w-r-1, y+r, r, 1, h-2*r-1, color);
-	fillCircleHelper(x+r    , y+r, r, 2, h-2*r-1, color);
+	// The centre block runs full height over every column from one corner
+	// centre to the other, both included. With w == 2r the centres sit side
+	// by side, each in the other half, so the halves start past the far
+	// centre and no column is written twice.
+	const int16_t left = std::min<int16_t>(x+r, x+w-r-1);
+	const int16_t right = std::max<int16_t>(x+r, x+w-r-1);
+	const int16_t firstColumn = right - (x+w-r-1) + 1;
+	render([&](auto& t) {
+		Raster::fillRect(t, _clip, left, y, right-left+1, h, color);
+		Raster::fillCircleHalves(t, _clip, x+w-r-1, y+r, r, 1, h-2*r-1, color, firstColumn);
+		Raster::fillCircleHalves(t, _clip, x+r    , y+r, r, 2, h-2*r-1, color, firstColumn);
+	});
 }
 
 /*!
@@ -494,64 +640,115 @@ void SSD1306_graphics::drawTriangle(int16_t x0, int16_t y0,
 void SSD1306_graphics::fillTriangle ( int16_t x0, int16_t y0,
 					int16_t x1, int16_t y1,
 					int16_t x2, int16_t y2, uint8_t color) {
+	render([&](auto& t) { Raster::fillTriangle(t, _clip, x0, y0, x1, y1, x2, y2, color); });
+}
 
-	int16_t a, b, y, last;
-
-	if (y0 > y1) {
-	swapInt16_OLED(y0, y1); swapInt16_OLED(x0, x1);
-	}
-	if (y1 > y2) {
-	swapInt16_OLED(y2, y1); swapInt16_OLED(x2, x1);
-	}
-	if (y0 > y1) {
-	swapInt16_OLED(y0, y1); swapInt16_OLED(x0, x1);
-	}
-
-	if(y0 == y2) { 
-	a = b = x0;
-	if(x1 < a)      a = x1;
-	else if(x1 > b) b = x1;
-	if(x2 < a)      a = x2;
-	else if(x2 > b) b = x2;
-	drawFastHLine(a, y0, b-a+1, color);
-	return;
-	}
+/*!
+	@brief Segment masks for drawSegmentNumber, bit 0 to 6 = segments a to g.
+	@details Characters 0-9 then '-' and ' '.
+*/
+static constexpr std::array<uint8_t, 12> SegmentDigits = {
+	0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F, 0x40, 0x00
+};
 
-	int16_t
-	dx01 = x1 - x0,
-	dy01 = y1 - y0,
-	dx02 = x2 - x0,
-	dy02 = y2 - y0,
-	dx12 = x2 - x1,
-	dy12 = y2 - y1;
-	int32_t
-	sa   = 0,
-	sb   = 0;
-
-	if(y1 == y2) last = y1;   
-	else         last = y1-1; 
-
-	for(y=y0; y<=last; y++) {
-	a   = x0 + sa / dy01;
-	b   = x0 + sb / dy02;
-	sa += dx01;
-	sb += dx02;
-
-	if(a > b) swapInt16_OLED(a,b);
-	drawFastHLine(a, y, b-a+1, color);
+/*!
+	@brief Fills one tapered seven segment bar with vertical spans, used internally by drawSegmentNumber
+	@param x0 left column of the bar
+	@param y0 top row of the bar
+	@param x1 right column of the bar
+	@param y1 bottom row of the bar
+	@param vertical true for b c e f bars, which taper at their top and bottom
+	@param color color of the bar
+*/
+void SSD1306_graphics::drawSegment(int16_t x0, int16_t y0, int16_t x1, int16_t y1, bool vertical, uint8_t color)
+{
+	int16_t thickness = vertical ? (x1 - x0 + 1) : (y1 - y0 + 1);
+	for (int16_t col = x0; col <= x1; col++)
+	{
+		int16_t inset;
+		if (vertical) {
+			// pointed top and bottom, longest span in the middle column
+			inset = abs((2 * (col - x0)) - (thickness - 1)) / 2;
+		} else {
+			// pointed left and right ends
+			int16_t edge = std::min(col - x0, x1 - col);
+			inset = std::max(0, (thickness / 2) - edge);
+		}
+		int16_t top = y0 + inset;
+		int16_t bottom = y1 - inset;
+		if (top <= bottom) drawFastVLine(col, top, bottom - top + 1, color);
 	}
+}
 
+/*!
+	@brief Width of a text drawn by drawSegmentNumber
+	@param h digit height in pixels
+	@param text the text
+	@return width in pixels including the gap after the last character
+*/
+int16_t SSD1306_graphics::measureSegmentNumber(int16_t h, const char *text)
+{
+	if (text == nullptr) return 0;
+	int16_t thickness = std::max<int16_t>(1, h / 9);
+	int16_t digitWidth = (h + 1) / 2;
+	int16_t width = 0;
+	for (; *text != '\0'; text++)
+		width += ((*text == '.' || *text == ':') ? thickness : digitWidth) + thickness;
+	return width;
+}
 
-	sa = dx12 * (y - y1);
-	sb = dx02 * (y - y0);
-	for(; y<=y2; y++) {
-	a   = x1 + sa / dy12;
-	b   = x0 + sb / dy02;
-	sa += dx12;
-	sb += dx02;
-	if(a > b) swapInt16_OLED(a,b);
-	drawFastHLine(a, y, b-a+1, color);
+/*!
+	@brief Draws a number as seven segment digits of any height, no font is needed.
+	@param x left edge of the first digit
+	@param y top of the digits
+	@param h digit height in pixels, digits are h/2 wide
+	@param text characters 0-9 - . : and space
+	@param color color of the lit segments
+	@return Will return
+		-# Success
+		-# CharArrayNullptr text invalid pointer object
+		-# CharFontASCIIRange a character with no segment pattern, drawing stops
+	@note Every segment is a set of vertical spans, the cost follows the lit area.
+		Unlit segments are not drawn, clear the area first if needed.
+*/
+DisplayRet::Ret_Codes_e SSD1306_graphics::drawSegmentNumber(int16_t x, int16_t y, int16_t h, const char *text, uint8_t color)
+{
+	if (text == nullptr) return DisplayRet::CharArrayNullptr;
+	const int16_t t = std::max<int16_t>(1, h / 9); // segment thickness
+	const int16_t w = (h + 1) / 2;
+	const int16_t midTop = y + (h / 2) - (t / 2);
+	for (; *text != '\0'; text++)
+	{
+		if (*text == '.' || *text == ':')
+		{
+			if (*text == '.') {
+				fillRect(x, y + h - t, t, t, color);
+			} else {
+				fillRect(x, y + (h / 3) - (t / 2), t, t, color);
+				fillRect(x, y + ((2 * h) / 3) - (t / 2), t, t, color);
+			}
+			x += 2 * t;
+			continue;
+		}
+		uint8_t segments;
+		if (*text >= '0' && *text <= '9') segments = SegmentDigits[*text - '0'];
+		else if (*text == '-') segments = SegmentDigits[10];
+		else if (*text == ' ') segments = SegmentDigits[11];
+		else return DisplayRet::CharFontASCIIRange;
+
+		// bars meet at the centre lines of their neighbours, one pixel apart
+		const int16_t left = x + 1, right = x + w - 2;
+		const int16_t topMid = y + (t / 2), midMid = midTop + (t / 2), botMid = y + h - 1 - (t / 2);
+		if (segments & 0x01) drawSegment(left, y, right, y + t - 1, false, color);                  // a
+		if (segments & 0x02) drawSegment(x + w - t, topMid + 1, x + w - 1, midMid - 1, true, color); // b
+		if (segments & 0x04) drawSegment(x + w - t, midMid + 1, x + w - 1, botMid - 1, true, color); // c
+		if (segments & 0x08) drawSegment(left, y + h - t, right, y + h - 1, false, color);          // d
+		if (segments & 0x10) drawSegment(x, midMid + 1, x + t - 1, botMid - 1, true, color);         // e
+		if (segments & 0x20) drawSegment(x, topMid + 1, x + t - 1, midMid - 1, true, color);         // f
+		if (segments & 0x40) drawSegment(left, midTop, right, midTop + t - 1, false, color);        // g
+		x += w + t;
 	}
+	return DisplayRet::Success;
 }
 
 /*! 
@@ -564,6 +761,26 @@ void SSD1306_graphics::setCursor(int16_t x, int16_t y) {
 	_cursor_y = y;
 }
 
+/*!
+	@brief set the integer scale text is drawn at
+	@param scale 1 (normal) to 4, out of range values are clamped
+	@note Scaled glyphs are expanded from the font a page byte at a time,
+		a small font at 2x or 3x can replace a dedicated large font.
+*/
+void SSD1306_graphics::setTextScale(uint8_t scale) {
+	if (scale < 1) scale = 1;
+	if (scale > 4) scale = 4;
+	_textScale = scale;
+}
+
+/*!
+	@brief Gets the integer text scale
+	@return text scale 1-4
+*/
+uint8_t SSD1306_graphics::getTextScale(void) const {
+	return _textScale;
+}
+
 /*!
 	@brief turn on or off screen _textwrap of the text (fonts 1-6)
 	@param w TRUE on
@@ -614,4 +831,31 @@ void SSD1306_graphics::setRotation(display_rotate_e CurrentRotation) {
 		_height = WIDTH;
 		break;
 	}
+	_drawable = ClipRect{0, 0, _width, _height};
+	resetClip();
+}
+
+/*!
+	@brief Limit all drawing to a rectangle, in current rotation co-ordinates
+	@param x left co-ordinate
+	@param y top co-ordinate
+	@param w width
+	@param h height
+	@note The rectangle is cut to the screen, or to the strip being rendered
+		in strip mode. Primitives and characters wholly outside it are skipped
+		before any pixel work, others are cut to it. setRotation resets the
+		clip rectangle.
+*/
+void SSD1306_graphics::setClipRect(int16_t x, int16_t y, int16_t w, int16_t h) {
+	_clip.x0 = std::clamp<int16_t>(x, _drawable.x0, _drawable.x1);
+	_clip.y0 = std::clamp<int16_t>(y, _drawable.y0, _drawable.y1);
+	_clip.x1 = std::clamp<int16_t>(x + std::max<int16_t>(w, 0), _clip.x0, _drawable.x1);
+	_clip.y1 = std::clamp<int16_t>(y + std::max<int16_t>(h, 0), _clip.y0, _drawable.y1);
+}
+
+/*!
+	@brief Set the clip rectangle back to the whole screen, or the whole strip in strip mode
+*/
+void SSD1306_graphics::resetClip(void) {
+	_clip = _drawable;
 }
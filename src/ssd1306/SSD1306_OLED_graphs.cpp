@@ -0,0 +1,303 @@
+/*!
+* @file SSD1306_OLED_graphs.cpp
+* @brief OLED driven by SSD1306 controller. Incremental sparkline, bar graph and dial gauge source file
+* @details <https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO>
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include "../../include/ssd1306/SSD1306_OLED_graphs.hpp"
+
+/*!
+	@brief init the sparkline, nothing is drawn until the first column completes
+	@param display display drawn on
+	@param x x co-ordinate of the chart area
+	@param y y co-ordinate of the chart area, multiple of 8 for the scrolling path
+	@param w width of the chart area, one column per time bucket, up to MaxColumns
+	@param h height of the chart area, multiple of 8 for the scrolling path
+	@param min value drawn on the bottom row
+	@param max value drawn on the top row
+	@param samplesPerColumn samples decimated to the min/max of one column
+*/
+SSD1306_Sparkline::SSD1306_Sparkline(SSD1306& display, int16_t x, int16_t y, int16_t w, int16_t h,
+	int16_t min, int16_t max, uint8_t samplesPerColumn)
+	: _display(display),
+	  _bounds{x, y, static_cast<int16_t>(x + std::min<int16_t>(w, MaxColumns)), static_cast<int16_t>(y + h)},
+	  _min(min), _max(max), _samplesPerColumn(std::max<uint8_t>(samplesPerColumn, 1))
+{
+}
+
+/*!
+	@brief Add a sample to the current time bucket
+	@param value sample, clamped to the chart range when drawn
+	@return true if a column completed and the chart changed on the buffer
+	@note A completed column scrolls the chart left by one column with
+		SSD1306::OLEDscrollRegionLeft and draws only the new column. When the
+		area cannot be scrolled, e.g. rotated or not page aligned, the whole
+		chart is redrawn instead.
+*/
+bool SSD1306_Sparkline::addSample(int16_t value)
+{
+	if (_bucketSamples == 0)
+	{
+		_bucket = Column_t{value, value};
+	} else {
+		_bucket.low = std::min(_bucket.low, value);
+		_bucket.high = std::max(_bucket.high, value);
+	}
+	if (++_bucketSamples < _samplesPerColumn) return false;
+
+	_history[_head] = _bucket;
+	_head = (_head + 1) % MaxColumns;
+	if (_count < MaxColumns) _count++;
+	_bucketSamples = 0;
+
+	const ClipRect& b = _bounds;
+	if (_display.OLEDscrollRegionLeft(b.x0, b.y0, b.x1 - b.x0, b.y1 - b.y0, 1) != DisplayRet::Success)
+	{
+		redraw();
+		return true;
+	}
+	drawColumn(b.x1 - 1, _bucket);
+	return true;
+}
+
+/*!
+	@brief Draw the whole chart from the history, e.g. after the buffer was cleared
+*/
+void SSD1306_Sparkline::redraw(void)
+{
+	const ClipRect& b = _bounds;
+	_display.fillRect(b.x0, b.y0, b.x1 - b.x0, b.y1 - b.y0, SSD1306::BLACK);
+	const uint8_t shown = std::min<int16_t>(_count, b.x1 - b.x0);
+	for (uint8_t age = 0; age < shown; age++)
+	{
+		const uint8_t slot = (_head + MaxColumns - 1 - age) % MaxColumns;
+		drawColumn(b.x1 - 1 - age, _history[slot]);
+	}
+}
+
+/*!
+	@brief Forget the history, the buffer is not touched until the next redraw
+*/
+void SSD1306_Sparkline::clear(void)
+{
+	_head = 0;
+	_count = 0;
+	_bucketSamples = 0;
+}
+
+/*!
+	@brief Draw one column as a vertical span from its low to its high value, used internally
+	@param x column
+	@param column time bucket drawn
+*/
+void SSD1306_Sparkline::drawColumn(int16_t x, const Column_t& column)
+{
+	const ClipRect& b = _bounds;
+	const int16_t top = rowOf(column.high);
+	const int16_t bottom = rowOf(column.low);
+	_display.drawFastVLine(x, b.y0, b.y1 - b.y0, SSD1306::BLACK);
+	_display.drawFastVLine(x, top, bottom - top + 1, SSD1306::WHITE);
+}
+
+/*!
+	@brief Row a value is drawn on, used internally
+	@param value sample
+	@return row inside the chart area, the maximum on the top row
+*/
+int16_t SSD1306_Sparkline::rowOf(int16_t value) const
+{
+	const int32_t range = std::max<int32_t>(_max - _min, 1);
+	const int32_t clamped = std::clamp<int32_t>(value, _min, _max);
+	return (_bounds.y1 - 1) - (((clamped - _min) * (_bounds.y1 - _bounds.y0 - 1)) / range);
+}
+
+/*!
+	@brief init the bar graph, call redraw to draw the outline
+	@param display display drawn on
+	@param x x co-ordinate of the outline
+	@param y y co-ordinate of the outline
+	@param w width of the outline
+	@param h height of the outline
+	@param min value shown as an empty bar
+	@param max value shown as a full bar
+*/
+SSD1306_BarGraph::SSD1306_BarGraph(SSD1306& display, int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max)
+	: _display(display),
+	  _bounds{x, y, static_cast<int16_t>(x + w), static_cast<int16_t>(y + h)},
+	  _min(min), _max(max)
+{
+}
+
+/*!
+	@brief Move the bar to a new value
+	@param value bar value, clamped to the bar range
+	@return true if the bar length changed on the buffer
+	@note Only the columns between the old and new bar ends are filled or
+		cleared, each a vertical span written with page masks.
+*/
+bool SSD1306_BarGraph::setValue(int32_t value)
+{
+	const int16_t fill = fillOf(value);
+	if (fill == _fill) return false;
+	const int16_t left = _bounds.x0 + 1 + std::min(fill, _fill);
+	const int16_t width = std::abs(fill - _fill);
+	_display.fillRect(left, _bounds.y0 + 1, width, _bounds.y1 - _bounds.y0 - 2,
+		(fill > _fill) ? SSD1306::WHITE : SSD1306::BLACK);
+	_fill = fill;
+	return true;
+}
+
+/*!
+	@brief Draw the outline and the bar, e.g. after the buffer was cleared
+*/
+void SSD1306_BarGraph::redraw(void)
+{
+	const ClipRect& b = _bounds;
+	const int16_t w = b.x1 - b.x0;
+	const int16_t h = b.y1 - b.y0;
+	_display.fillRect(b.x0, b.y0, w, h, SSD1306::BLACK);
+	_display.drawRect(b.x0, b.y0, w, h, SSD1306::WHITE);
+	_display.fillRect(b.x0 + 1, b.y0 + 1, _fill, h - 2, SSD1306::WHITE);
+}
+
+/*!
+	@brief Filled columns for a value, used internally
+	@param value bar value
+	@return columns inside the outline
+*/
+int16_t SSD1306_BarGraph::fillOf(int32_t value) const
+{
+	const int32_t range = std::max<int32_t>(_max - _min, 1);
+	const int32_t clamped = std::clamp(value, _min, _max);
+	return ((clamped - _min) * (_bounds.x1 - _bounds.x0 - 2)) / range;
+}
+
+/*!
+	@brief init the gauge, call drawFace and redraw to draw it
+	@param display display drawn on
+	@param cx x co-ordinate of the needle pivot
+	@param cy y co-ordinate of the needle pivot
+	@param radius outer edge of the dial ticks
+	@param needle needle tip distance from the pivot
+	@param startAngle angle of min in FixedTrig::AngleSteps per turn, 0 points right and angles run clockwise
+	@param sweep angle from min to max
+	@param min value at the start of the dial
+	@param max value at the end of the dial
+*/
+SSD1306_Gauge::SSD1306_Gauge(SSD1306& display, int16_t cx, int16_t cy, int16_t radius, int16_t needle,
+	uint16_t startAngle, uint16_t sweep, int32_t min, int32_t max)
+	: _display(display), _cx(cx), _cy(cy), _radius(radius), _needle(needle),
+	  _startAngle(startAngle), _sweep(sweep), _min(min), _max(max), _angle(startAngle)
+{
+}
+
+/*!
+	@brief Draw the dial arc, ticks and hub, the needle is not drawn
+	@param divisions major tick intervals, a major tick at both ends
+	@param minorPerDivision minor tick intervals per major interval
+	@note Meant to be drawn once into a background layer, labels are left
+		to the caller, see pointAt.
+*/
+void SSD1306_Gauge::drawFace(uint8_t divisions, uint8_t minorPerDivision)
+{
+	int16_t x, y;
+	for (uint16_t step = 0; step <= _sweep; step++)
+	{
+		pointAtAngle(_startAngle + step, _radius, x, y);
+		_display.drawPixel(x, y, SSD1306::WHITE);
+	}
+
+	const uint16_t ticks = std::max<uint16_t>(divisions, 1) * std::max<uint8_t>(minorPerDivision, 1);
+	for (uint16_t tick = 0; tick <= ticks; tick++)
+	{
+		const uint16_t angle = _startAngle + (static_cast<uint32_t>(_sweep) * tick) / ticks;
+		const int16_t length = (tick % std::max<uint8_t>(minorPerDivision, 1) == 0) ? MajorTick : MinorTick;
+		int16_t x0, y0;
+		pointAtAngle(angle, _radius - length, x0, y0);
+		pointAtAngle(angle, _radius, x, y);
+		_display.drawLine(x0, y0, x, y, SSD1306::WHITE);
+	}
+	_display.fillCircle(_cx, _cy, HubRadius, SSD1306::WHITE);
+}
+
+/*!
+	@brief Point on the dial for a value, e.g. to place a scale label
+	@param value value, clamped to the dial range
+	@param radius distance from the pivot
+	@param x returns the x co-ordinate
+	@param y returns the y co-ordinate
+*/
+void SSD1306_Gauge::pointAt(int32_t value, int16_t radius, int16_t& x, int16_t& y) const
+{
+	pointAtAngle(angleOf(value), radius, x, y);
+}
+
+/*!
+	@brief Move the needle to a new value
+	@param value needle value, clamped to the dial range
+	@return true if the needle moved on the buffer, damage() covers both positions
+	@note The needle is drawn with SSD1306::INVERSE, so drawing the old line
+		again erases it and restores the face pixels under it. Only the old
+		and new needle pixels are touched. Expects the needle drawn by redraw.
+*/
+bool SSD1306_Gauge::setValue(int32_t value)
+{
+	const uint16_t angle = angleOf(value);
+	if (angle == _angle) return false;
+	const ClipRect before = drawNeedle(_angle);
+	const ClipRect after = drawNeedle(angle);
+	_angle = angle;
+	_damage = ClipRect{std::min(before.x0, after.x0), std::min(before.y0, after.y0),
+		std::max(before.x1, after.x1), std::max(before.y1, after.y1)};
+	return true;
+}
+
+/*!
+	@brief Draw the needle over a face without one, e.g. after the face was restored
+*/
+void SSD1306_Gauge::redraw(void)
+{
+	_damage = drawNeedle(_angle);
+}
+
+/*!
+	@brief Needle angle for a value, used internally
+	@param value needle value
+	@return angle in FixedTrig::AngleSteps per turn
+*/
+uint16_t SSD1306_Gauge::angleOf(int32_t value) const
+{
+	const int32_t range = std::max<int32_t>(_max - _min, 1);
+	const int32_t clamped = std::clamp(value, _min, _max);
+	return _startAngle + (static_cast<int64_t>(clamped - _min) * _sweep) / range;
+}
+
+/*!
+	@brief Point at an angle and distance from the pivot, used internally
+	@param angle angle in FixedTrig::AngleSteps per turn
+	@param radius distance from the pivot
+	@param x returns the x co-ordinate
+	@param y returns the y co-ordinate
+*/
+void SSD1306_Gauge::pointAtAngle(uint16_t angle, int16_t radius, int16_t& x, int16_t& y) const
+{
+	x = _cx + ((radius * FixedTrig::cosine(angle) + FixedTrig::One / 2) >> 14);
+	y = _cy + ((radius * FixedTrig::sine(angle) + FixedTrig::One / 2) >> 14);
+}
+
+/*!
+	@brief Toggle the needle pixels at an angle, used internally
+	@param angle needle angle
+	@return area of the needle, x1 and y1 exclusive
+*/
+ClipRect SSD1306_Gauge::drawNeedle(uint16_t angle)
+{
+	int16_t x0, y0, x1, y1;
+	pointAtAngle(angle, HubRadius + 2, x0, y0);
+	pointAtAngle(angle, _needle, x1, y1);
+	_display.drawLine(x0, y0, x1, y1, SSD1306::INVERSE);
+	return ClipRect{std::min(x0, x1), std::min(y0, y1),
+		static_cast<int16_t>(std::max(x0, x1) + 1), static_cast<int16_t>(std::max(y0, y1) + 1)};
+}
@@ -0,0 +1,95 @@
+/*!
+* @file SSD1306_OLED_log.cpp
+* @brief OLED driven by SSD1306 controller. Deferred binary log source file
+* @details <https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO>
+*/
+
+#include <cstdio>
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "../../include/ssd1306/SSD1306_OLED_log.hpp"
+
+namespace DeferredLog
+{
+
+static Record_t ring[RingSize];          /**< records, slot is index % RingSize */
+static volatile uint32_t writeIndex = 0; /**< slots handed out to log calls */
+static volatile uint32_t readIndex = 0;  /**< slots printed by drain */
+static volatile uint32_t droppedCount = 0; /**< records lost to a full ring */
+static uint32_t droppedReported = 0;     /**< droppedCount at the last drain report */
+
+/*!
+	@brief Store a log record, safe from any context including interrupt handlers
+	@param format printf format, must stay valid until drained, e.g. a string
+		literal. Up to three %d %i %u %x %c conversions, no strings or floats.
+	@param a first argument
+	@param b second argument
+	@param c third argument
+	@note Only taking the slot masks interrupts, for a handful of cycles, the
+		M0+ has no exclusive load and store to claim it otherwise. The record
+		is filled afterwards and marked complete last, a handler that logs in
+		between takes the next slot. When the ring is full the record is
+		dropped and counted.
+*/
+void log(const char* format, int32_t a, int32_t b, int32_t c)
+{
+	const uint32_t status = save_and_disable_interrupts();
+	const uint32_t index = writeIndex;
+	const bool full = (index - readIndex) >= RingSize;
+	if (full)
+		droppedCount = droppedCount + 1;
+	else
+		writeIndex = index + 1;
+	restore_interrupts(status);
+	if (full) return;
+
+	Record_t& record = ring[index % RingSize];
+	record.format = format;
+	record.time = time_us_32();
+	record.args[0] = a;
+	record.args[1] = b;
+	record.args[2] = c;
+	__dmb();
+	record.sequence = index + 1;
+}
+
+/*!
+	@brief Print stored records with printf, call from the main loop when idle
+	@param maxRecords most records printed in this call
+	@return number of records printed
+	@note Stops at a record still being filled by an interrupted log call.
+		Reports records dropped since the last call.
+*/
+size_t drain(size_t maxRecords)
+{
+	size_t count = 0;
+	while (count < maxRecords && readIndex != writeIndex)
+	{
+		const uint32_t index = readIndex;
+		const Record_t& record = ring[index % RingSize];
+		if (record.sequence != index + 1) break;
+		__dmb();
+		printf("[%10lu] ", static_cast<unsigned long>(record.time));
+		printf(record.format, static_cast<int>(record.args[0]), static_cast<int>(record.args[1]), static_cast<int>(record.args[2]));
+		__dmb();
+		readIndex = index + 1;
+		count++;
+	}
+	const uint32_t lost = droppedCount;
+	if (lost != droppedReported)
+	{
+		printf("DeferredLog: %lu records dropped\r\n", static_cast<unsigned long>(lost - droppedReported));
+		droppedReported = lost;
+	}
+	return count;
+}
+
+/*!
+	@brief Records dropped because the ring was full, since start up
+*/
+uint32_t dropped(void)
+{
+	return droppedCount;
+}
+
+} // namespace DeferredLog
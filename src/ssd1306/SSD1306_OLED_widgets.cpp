@@ -0,0 +1,627 @@
+/*!
+* @file SSD1306_OLED_widgets.cpp
+* @brief OLED driven by SSD1306 controller. Retained display list source file
+* @details <https://github.com/gavinlyonsrepo/SSD1306_OLED_PICO>
+*/
+
+#include <algorithm>
+#include <cstring>
+#include "../../include/ssd1306/SSD1306_OLED_widgets.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_format.hpp"
+#include "../../include/ssd1306/SSD1306_OLED_log.hpp"
+
+/*!
+	@brief init the display list
+	@param display display the widgets are drawn on and flushed to
+*/
+SSD1306_DisplayList::SSD1306_DisplayList(SSD1306& display) : _display(display)
+{
+}
+
+/*!
+	@brief Take a free pool slot, used internally by the add methods
+	@param id set to the new widget id
+	@param type kind of widget
+	@param x x co-ordinate of the widget area
+	@param y y co-ordinate of the widget area
+	@param w width of the widget area
+	@param h height of the widget area
+	@return Success or WidgetPoolFull
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::allocate(uint8_t& id, WidgetType_e type, int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	for (uint8_t slot = 0; slot < MaxWidgets; slot++)
+	{
+		if (_widgets[slot].type != WidgetFree) continue;
+		_widgets[slot] = Widget_t{};
+		_widgets[slot].type = type;
+		_widgets[slot].bounds = ClipRect{x, y, static_cast<int16_t>(x + w), static_cast<int16_t>(y + h)};
+		_widgets[slot].anchor = x;
+		_widgets[slot].version = 1; // never drawn
+		id = slot;
+		return DisplayRet::Success;
+	}
+	DeferredLog::log("SSD1306_DisplayList::allocate Error: all %u widget slots in use\r\n", MaxWidgets);
+	return DisplayRet::WidgetPoolFull;
+}
+
+/*!
+	@brief Look up a widget, used internally
+	@param id widget id
+	@param type expected kind, WidgetFree accepts any kind in use
+	@return widget or nullptr
+*/
+SSD1306_DisplayList::Widget_t* SSD1306_DisplayList::find(uint8_t id, WidgetType_e type)
+{
+	if (id >= MaxWidgets || _widgets[id].type == WidgetFree) return nullptr;
+	if (type != WidgetFree && _widgets[id].type != type) return nullptr;
+	return &_widgets[id];
+}
+
+/*!
+	@brief Add a text field
+	@param id set to the new widget id
+	@param x x co-ordinate of the widget area
+	@param y y co-ordinate of the widget area
+	@param w width of the widget area
+	@param h height of the widget area
+	@param font font the text is drawn in
+	@param align text alignment inside the area
+	@param scale text scale 1-4
+	@return Success or WidgetPoolFull
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addText(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+	std::span<const uint8_t> font, SSD1306_graphics::text_align_e align, uint8_t scale)
+{
+	DisplayRet::Ret_Codes_e ret = allocate(id, WidgetText, x, y, w, h);
+	if (ret != DisplayRet::Success) return ret;
+	Widget_t& widget = _widgets[id];
+	widget.font = font;
+	widget.scale = scale;
+	widget.align = align;
+	widget.anchor = (align == SSD1306_graphics::alignLeft) ? x : (align == SSD1306_graphics::alignCenter) ? x + (w / 2) : x + w;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Add a fixed point number field
+	@param id set to the new widget id
+	@param x x co-ordinate of the widget area
+	@param y y co-ordinate of the widget area
+	@param w width of the widget area
+	@param h height of the widget area
+	@param font font the number is drawn in
+	@param decimals digits after the point, setNumber(123) with 1 decimal shows 12.3
+	@param align text alignment inside the area
+	@param scale text scale 1-4
+	@return Success or WidgetPoolFull
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addNumber(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+	std::span<const uint8_t> font, uint8_t decimals, SSD1306_graphics::text_align_e align, uint8_t scale)
+{
+	DisplayRet::Ret_Codes_e ret = addText(id, x, y, w, h, font, align, scale);
+	if (ret != DisplayRet::Success) return ret;
+	_widgets[id].type = WidgetNumber;
+	_widgets[id].decimals = decimals;
+	formatNumber(_widgets[id]);
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Add a big number field that redraws only the characters that changed
+	@param id set to the new widget id
+	@param x x co-ordinate of the widget area
+	@param y y co-ordinate of the widget area
+	@param w width of the widget area
+	@param h height of the widget area
+	@param font font the text is drawn in, glyphs must stay inside their advance
+	@param align text alignment inside the area
+	@param scale text scale 1-4
+	@return Success or WidgetPoolFull
+	@note Bound with setText, which keeps the first MaxDigits characters.
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addDigits(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+	std::span<const uint8_t> font, SSD1306_graphics::text_align_e align, uint8_t scale)
+{
+	if (_cellsCount >= MaxDigitWidgets)
+	{
+		DeferredLog::log("SSD1306_DisplayList::addDigits Error: all %u digit caches in use\r\n", MaxDigitWidgets);
+		return DisplayRet::WidgetPoolFull;
+	}
+	DisplayRet::Ret_Codes_e ret = addText(id, x, y, w, h, font, align, scale);
+	if (ret != DisplayRet::Success) return ret;
+	_widgets[id].type = WidgetDigits;
+	_widgets[id].cells = _cellsCount;
+	_cells[_cellsCount++] = DigitCells_t{};
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Add an icon
+	@param id set to the new widget id
+	@param x x co-ordinate of the icon
+	@param y y co-ordinate of the icon
+	@param w width of the icon, divisible by 8
+	@param h height of the icon
+	@param bitmap horizontally addressed bitmap, as OLEDBitmap
+	@return Success or WidgetPoolFull
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addIcon(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h, std::span<const uint8_t> bitmap)
+{
+	DisplayRet::Ret_Codes_e ret = allocate(id, WidgetIcon, x, y, w, h);
+	if (ret != DisplayRet::Success) return ret;
+	_widgets[id].bitmap = bitmap;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Add a horizontal bar graph
+	@param id set to the new widget id
+	@param x x co-ordinate of the bar outline
+	@param y y co-ordinate of the bar outline
+	@param w width of the bar outline
+	@param h height of the bar outline
+	@param min value shown as an empty bar
+	@param max value shown as a full bar
+	@return Success or WidgetPoolFull
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addBar(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h, int32_t min, int32_t max)
+{
+	DisplayRet::Ret_Codes_e ret = allocate(id, WidgetBar, x, y, w, h);
+	if (ret != DisplayRet::Success) return ret;
+	_widgets[id].min = min;
+	_widgets[id].max = max;
+	_widgets[id].value = min;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Add a line chart of caller owned samples
+	@param id set to the new widget id
+	@param x x co-ordinate of the chart area
+	@param y y co-ordinate of the chart area
+	@param w width of the chart area
+	@param h height of the chart area
+	@param samples sample values, oldest first, kept by the caller
+	@param min value drawn on the bottom row
+	@param max value drawn on the top row
+	@return Success or WidgetPoolFull
+	@note Call touch() after changing the samples.
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::addChart(uint8_t& id, int16_t x, int16_t y, int16_t w, int16_t h,
+	std::span<const int16_t> samples, int16_t min, int16_t max)
+{
+	DisplayRet::Ret_Codes_e ret = allocate(id, WidgetChart, x, y, w, h);
+	if (ret != DisplayRet::Success) return ret;
+	_widgets[id].samples = samples;
+	_widgets[id].min = min;
+	_widgets[id].max = max;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Free every widget and forget pending damage
+*/
+void SSD1306_DisplayList::clear(void)
+{
+	for (Widget_t& widget : _widgets) widget.type = WidgetFree;
+	_damageCount = 0;
+	_cellsCount = 0;
+}
+
+/*!
+	@brief Bind new text to a text or digits widget
+	@param id widget id
+	@param text new content, cut to MaxTextLength or MaxDigits characters
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setText(uint8_t id, const char* text)
+{
+	Widget_t* widget = find(id, WidgetFree);
+	if (widget == nullptr || text == nullptr) return DisplayRet::WidgetInvalid;
+	if (widget->type != WidgetText && widget->type != WidgetDigits) return DisplayRet::WidgetInvalid;
+	const uint8_t length = (widget->type == WidgetDigits) ? MaxDigits : MaxTextLength;
+	if (strncmp(widget->text, text, length) == 0) return DisplayRet::Success;
+	strncpy(widget->text, text, length);
+	widget->text[length] = '\0';
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Bind a new value to a number widget
+	@param id widget id
+	@param value value in units of the last decimal shown
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setNumber(uint8_t id, int32_t value)
+{
+	Widget_t* widget = find(id, WidgetNumber);
+	if (widget == nullptr) return DisplayRet::WidgetInvalid;
+	if (widget->value == value) return DisplayRet::Success;
+	widget->value = value;
+	formatNumber(*widget);
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Bind a new bitmap to an icon widget
+	@param id widget id
+	@param bitmap new bitmap, same size as the widget
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setIcon(uint8_t id, std::span<const uint8_t> bitmap)
+{
+	Widget_t* widget = find(id, WidgetIcon);
+	if (widget == nullptr) return DisplayRet::WidgetInvalid;
+	if (widget->bitmap.data() == bitmap.data() && widget->bitmap.size() == bitmap.size()) return DisplayRet::Success;
+	widget->bitmap = bitmap;
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Bind a new value to a bar widget
+	@param id widget id
+	@param value bar value, clamped to the bar range when drawn
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setBar(uint8_t id, int32_t value)
+{
+	Widget_t* widget = find(id, WidgetBar);
+	if (widget == nullptr) return DisplayRet::WidgetInvalid;
+	if (widget->value == value) return DisplayRet::Success;
+	widget->value = value;
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Change the alignment of a text, number or digits widget
+	@param id widget id
+	@param align text alignment
+	@param anchor x co-ordinate the text is aligned against
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setTextAlign(uint8_t id, SSD1306_graphics::text_align_e align, int16_t anchor)
+{
+	Widget_t* widget = find(id, WidgetFree);
+	if (widget == nullptr || widget->type == WidgetIcon || widget->type == WidgetBar || widget->type == WidgetChart)
+		return DisplayRet::WidgetInvalid;
+	if (widget->align == align && widget->anchor == anchor) return DisplayRet::Success;
+	widget->align = align;
+	widget->anchor = anchor;
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Draw a widget inverted, white background and black content
+	@param id widget id
+	@param invert true for inverted
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::setInvert(uint8_t id, bool invert)
+{
+	Widget_t* widget = find(id, WidgetFree);
+	if (widget == nullptr) return DisplayRet::WidgetInvalid;
+	if (widget->invert == invert) return DisplayRet::Success;
+	widget->invert = invert;
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Mark a widget changed, for data the list cannot compare such as chart samples
+	@param id widget id
+	@return Success or WidgetInvalid
+*/
+DisplayRet::Ret_Codes_e SSD1306_DisplayList::touch(uint8_t id)
+{
+	Widget_t* widget = find(id, WidgetFree);
+	if (widget == nullptr) return DisplayRet::WidgetInvalid;
+	widget->version++;
+	return DisplayRet::Success;
+}
+
+/*!
+	@brief Set the static layer copied back under widgets before they redraw
+	@param layer background saved by SSD1306::OLEDsaveBackground, empty to clear to black
+	@note The layer is kept by the caller. Call invalidateAll after changing it.
+*/
+void SSD1306_DisplayList::setBackground(std::span<const uint8_t> layer)
+{
+	_background = layer;
+}
+
+/*!
+	@brief Redraw every widget and flush the whole screen on the next flush
+	@note Use after the buffer was cleared or drawn over, e.g. on a screen change.
+*/
+void SSD1306_DisplayList::invalidateAll(void)
+{
+	for (Widget_t& widget : _widgets)
+		if (widget.type != WidgetFree) widget.drawnVersion = widget.version - 1;
+	for (DigitCells_t& cells : _cells) cells.valid = false;
+	_damageCount = 0;
+	addDamage(0, 0, _display.width(), _display.height());
+}
+
+/*!
+	@brief Record a region to send on the next flush
+	@param x x co-ordinate of the region
+	@param y y co-ordinate of the region
+	@param w width of the region
+	@param h height of the region
+	@note A region overlapping a recorded one is merged into it, when the
+		list is full the region is merged into the last entry.
+*/
+void SSD1306_DisplayList::addDamage(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+	if (w <= 0 || h <= 0) return;
+	ClipRect rect{x, y, static_cast<int16_t>(x + w), static_cast<int16_t>(y + h)};
+	uint8_t target = _damageCount;
+	for (uint8_t i = 0; i < _damageCount; i++)
+	{
+		if (overlaps(_damage[i], rect)) { target = i; break; }
+	}
+	if (target == _damageCount && _damageCount < MaxDamage)
+	{
+		_damage[_damageCount++] = rect;
+		return;
+	}
+	if (target == _damageCount) target = _damageCount - 1;
+	ClipRect& merged = _damage[target];
+	merged.x0 = std::min(merged.x0, rect.x0);
+	merged.y0 = std::min(merged.y0, rect.y0);
+	merged.x1 = std::max(merged.x1, rect.x1);
+	merged.y1 = std::max(merged.y1, rect.y1);
+}
+
+/*!
+	@brief true if two rectangles share a pixel
+*/
+bool SSD1306_DisplayList::overlaps(const ClipRect& a, const ClipRect& b)
+{
+	return (a.x0 < b.x1) && (b.x0 < a.x1) && (a.y0 < b.y1) && (b.y0 < a.y1);
+}
+
+/*!
+	@brief true if a widget puts pixels on the screen, used internally
+	@note Blank widgets need no redraw when an overlapping widget clears their area.
+*/
+bool SSD1306_DisplayList::hasContent(const Widget_t& widget)
+{
+	if (widget.invert) return true;
+	if (widget.type == WidgetText || widget.type == WidgetDigits) return widget.text[0] != '\0';
+	return true;
+}
+
+/*!
+	@brief Redraw the widgets whose bound data changed since they were drawn
+	@return number of widgets redrawn
+	@note A widget clears its bounds before a redraw, to black or from the
+		background layer. A digits widget with a valid cell cache clears only
+		the span of cells that changed. A widget with content overlapping a
+		cleared area is redrawn too. All areas are cleared first, then the
+		widgets are drawn in pool order, each clipped to its cleared area.
+		The display font, text scale and invert font setting are left as the
+		last widget set them.
+*/
+uint8_t SSD1306_DisplayList::render(void)
+{
+	std::array<ClipRect, MaxWidgets> cleared{}; // empty for widgets left alone
+	std::array<bool, MaxWidgets> repaint{};     // whole bounds cleared
+	for (uint8_t i = 0; i < MaxWidgets; i++)
+	{
+		Widget_t& widget = _widgets[i];
+		if (widget.type == WidgetFree || widget.version == widget.drawnVersion) continue;
+		if (widget.type == WidgetDigits && _cells[widget.cells].valid)
+		{
+			cleared[i] = diffDigits(widget);
+		} else {
+			repaint[i] = true;
+			cleared[i] = widget.bounds;
+		}
+	}
+
+	bool spread = true;
+	while (spread)
+	{
+		spread = false;
+		for (uint8_t i = 0; i < MaxWidgets; i++)
+		{
+			if (cleared[i].x1 <= cleared[i].x0) continue;
+			for (uint8_t j = 0; j < MaxWidgets; j++)
+			{
+				Widget_t& other = _widgets[j];
+				if (j == i || other.type == WidgetFree || repaint[j]) continue;
+				if (!overlaps(cleared[i], other.bounds)) continue;
+				if (other.version == other.drawnVersion && !hasContent(other)) continue;
+				other.drawnVersion = other.version - 1;
+				repaint[j] = true;
+				cleared[j] = other.bounds;
+				spread = true;
+			}
+		}
+	}
+
+	for (uint8_t i = 0; i < MaxWidgets; i++)
+	{
+		const ClipRect& area = cleared[i];
+		if (area.x1 <= area.x0) continue;
+		if (!_background.empty() && !_widgets[i].invert)
+			_display.OLEDrestoreRegion(_background, area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
+		else
+			_display.fillRect(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0,
+				_widgets[i].invert ? SSD1306::WHITE : SSD1306::BLACK);
+	}
+
+	uint8_t drawn = 0;
+	for (uint8_t i = 0; i < MaxWidgets; i++)
+	{
+		Widget_t& widget = _widgets[i];
+		if (widget.type == WidgetFree || widget.version == widget.drawnVersion) continue;
+		widget.drawnVersion = widget.version;
+		const ClipRect& area = cleared[i];
+		if (area.x1 <= area.x0) continue;
+		if (widget.type == WidgetDigits && repaint[i]) diffDigits(widget); // refresh the cell cache
+		drawWidget(widget, area);
+		addDamage(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
+		drawn++;
+	}
+	return drawn;
+}
+
+/*!
+	@brief Lay out a digits widget, compare with the cells drawn last and
+		keep the new layout, used internally by render
+	@param widget digits widget
+	@return span of the old and new cells that differ, empty if none
+*/
+ClipRect SSD1306_DisplayList::diffDigits(Widget_t& widget)
+{
+	DigitCells_t& cells = _cells[widget.cells];
+	_display.setFont(widget.font);
+	_display.setTextScale(widget.scale);
+
+	int16_t x = widget.anchor;
+	switch (widget.align)
+	{
+		case SSD1306_graphics::alignLeft: break;
+		case SSD1306_graphics::alignCenter: x -= _display.measureString(widget.text) / 2; break;
+		case SSD1306_graphics::alignRight: x -= _display.measureString(widget.text); break;
+	}
+
+	const uint8_t count = strlen(widget.text);
+	ClipRect span{widget.bounds.x1, widget.bounds.y0, widget.bounds.x0, widget.bounds.y1};
+	auto cover = [&span](int16_t left, uint8_t width) {
+		span.x0 = std::min(span.x0, left);
+		span.x1 = std::max<int16_t>(span.x1, left + width);
+	};
+	for (uint8_t i = 0; i < std::max(count, cells.count); i++)
+	{
+		const uint8_t width = (i < count) ? _display.measureChar(widget.text[i]) : 0;
+		const bool same = (i < count) && (i < cells.count) && (cells.text[i] == widget.text[i])
+			&& (cells.x[i] == x) && (cells.width[i] == width);
+		if (!same)
+		{
+			if (i < cells.count) cover(cells.x[i], cells.width[i]);
+			if (i < count) cover(x, width);
+		}
+		if (i < count)
+		{
+			cells.text[i] = widget.text[i];
+			cells.x[i] = x;
+			cells.width[i] = width;
+		}
+		x += width;
+	}
+	cells.count = count;
+	cells.valid = true;
+
+	span.x0 = std::max(span.x0, widget.bounds.x0);
+	span.x1 = std::min(span.x1, widget.bounds.x1);
+	if (span.x1 <= span.x0) return ClipRect{};
+	return span;
+}
+
+/*!
+	@brief Draw every widget over a cleared buffer, e.g. as the callback of
+		SSD1306::OLEDupdateStrips
+	@note Versions, cell caches and damage are left alone, the retained
+		state still describes the full buffer. The background layer is not
+		used, draw it first if needed.
+*/
+void SSD1306_DisplayList::drawAll(void)
+{
+	for (Widget_t& widget : _widgets)
+	{
+		if (widget.type == WidgetFree) continue;
+		const ClipRect& b = widget.bounds;
+		if (widget.invert)
+			_display.fillRect(b.x0, b.y0, b.x1 - b.x0, b.y1 - b.y0, SSD1306::WHITE);
+		drawWidget(widget, b);
+	}
+}
+
+/*!
+	@brief Send the damaged regions to the screen and forget them
+*/
+void SSD1306_DisplayList::flush(void)
+{
+	for (uint8_t i = 0; i < _damageCount; i++)
+	{
+		const ClipRect& rect = _damage[i];
+		_display.OLEDupdateRegion(rect.x0, rect.y0, rect.x1 - rect.x0, rect.y1 - rect.y0);
+	}
+	_damageCount = 0;
+}
+
+/*!
+	@brief Write a number widget's value as text, used internally
+	@param widget number widget
+*/
+void SSD1306_DisplayList::formatNumber(Widget_t& widget)
+{
+	FixedFormat::formatFixed(widget.text, sizeof(widget.text), widget.value, 0, widget.decimals, FixedFormat::AlignLeft);
+}
+
+/*!
+	@brief Draw a widget over its cleared area, used internally by render
+	@param widget widget to draw
+	@param area cleared part of the widget bounds, drawing is clipped to it
+*/
+void SSD1306_DisplayList::drawWidget(Widget_t& widget, const ClipRect& area)
+{
+	const ClipRect& b = widget.bounds;
+	const int16_t w = b.x1 - b.x0;
+	const int16_t h = b.y1 - b.y0;
+	const uint8_t fg = widget.invert ? SSD1306::BLACK : SSD1306::WHITE;
+
+	_display.setClipRect(area.x0, area.y0, area.x1 - area.x0, area.y1 - area.y0);
+	switch (widget.type)
+	{
+		case WidgetText:
+		case WidgetNumber:
+		case WidgetDigits:
+			if (widget.text[0] == '\0') break;
+			_display.setFont(widget.font);
+			_display.setTextScale(widget.scale);
+			_display.setInvertFont(widget.invert);
+			_display.drawText(widget.anchor, b.y0, widget.text, widget.align);
+		break;
+		case WidgetIcon:
+			_display.OLEDBitmap(b.x0, b.y0, w, h, widget.bitmap, widget.invert);
+		break;
+		case WidgetBar:
+		{
+			int32_t range = std::max<int32_t>(widget.max - widget.min, 1);
+			int32_t value = std::clamp(widget.value, widget.min, widget.max);
+			int16_t fill = ((value - widget.min) * (w - 2)) / range;
+			_display.drawRect(b.x0, b.y0, w, h, fg);
+			_display.fillRect(b.x0 + 1, b.y0 + 1, fill, h - 2, fg);
+		}
+		break;
+		case WidgetChart:
+		{
+			const size_t count = widget.samples.size();
+			if (count < 2) break;
+			int32_t range = std::max<int32_t>(widget.max - widget.min, 1);
+			int16_t lastX = 0, lastY = 0;
+			for (size_t i = 0; i < count; i++)
+			{
+				int32_t sample = std::clamp<int32_t>(widget.samples[i], widget.min, widget.max);
+				int16_t px = b.x0 + ((i * (w - 1)) / (count - 1));
+				int16_t py = b.y1 - 1 - (((sample - widget.min) * (h - 1)) / range);
+				if (i > 0) _display.drawLine(lastX, lastY, px, py, fg);
+				lastX = px;
+				lastY = py;
+			}
+		}
+		break;
+		default: break;
+	}
+	_display.resetClip();
+}
@@ -0,0 +1,148 @@
+/*!
+* @file pulse_capture.cpp
+* @brief Tachometer. Hall sensor edge timestamps captured by PIO and DMA source file
+*/
+
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "../../include/tach/pulse_capture.hpp"
+#include "pulse_capture.pio.h"
+
+/*!
+	@brief Load the PIO program and start capturing falling edges of a pin
+	@param pio PIO block to run on, pio0 or pio1
+	@param pin GPIO of the sensor, set up as an input beforehand
+	@return false if no state machine, program space or DMA channel is free,
+		nothing is claimed then
+*/
+bool PulseCapture::begin(PIO pio, uint pin)
+{
+	if (!pio_can_add_program(pio, &pulse_capture_program)) return false;
+	const int sm = pio_claim_unused_sm(pio, false);
+	if (sm < 0) return false;
+	const int dma = dma_claim_unused_channel(false);
+	if (dma < 0)
+	{
+		pio_sm_unclaim(pio, sm);
+		return false;
+	}
+	_pio = pio;
+	_sm = static_cast<uint>(sm);
+	_dma = dma;
+
+	const uint offset = pio_add_program(pio, &pulse_capture_program);
+	pulse_capture_program_init(pio, _sm, offset, pin);
+
+	dma_channel_config config = dma_channel_get_default_config(_dma);
+	channel_config_set_transfer_data_size(&config, DMA_SIZE_32);
+	channel_config_set_read_increment(&config, false);
+	channel_config_set_write_increment(&config, true);
+	channel_config_set_ring(&config, true, __builtin_ctz(RingBytes));
+	channel_config_set_dreq(&config, pio_get_dreq(pio, _sm, false));
+	dma_channel_configure(_dma, &config, _ring, &pio->rxf[_sm], DmaRun, true);
+
+	_sampleCount = 0;
+	_sampleTime = time_us_32();
+	pio_sm_set_enabled(pio, _sm, true);
+	return true;
+}
+
+/*!
+	@brief Timestamps DMA has written since begin, modulo 2^32
+	@note A DMA run ends after DmaRun transfers, hours at any sensor rate,
+		it is restarted here at the same ring position. The joined RX FIFO
+		holds eight edges meanwhile.
+*/
+uint32_t PulseCapture::writtenCount(void)
+{
+	const uint32_t remaining = dma_channel_hw_addr(_dma)->transfer_count;
+	if (remaining == 0 && !dma_channel_is_busy(_dma))
+	{
+		_runBase += DmaRun;
+		dma_channel_set_trans_count(_dma, DmaRun, true);
+		return _runBase;
+	}
+	return _runBase + (DmaRun - remaining);
+}
+
+/*!
+	@brief Read the intervals between the edges captured since the last call
+	@param intervals destination, system clock cycles per interval
+	@param maxIntervals size of intervals, the rest stays for the next call
+	@return intervals written, 0 if there was no new edge
+	@note Call from the main loop only. If DMA has lapped the reader the
+		oldest half of the ring is skipped and counted in lost(), the next
+		interval then starts at the first edge kept.
+*/
+size_t PulseCapture::readIntervals(uint32_t* intervals, size_t maxIntervals)
+{
+	if (_dma < 0) return 0;
+	const uint32_t written = writtenCount();
+	if (written - _read > RingSize - 1)
+	{
+		_lost += (written - _read) - RingSize / 2;
+		_read = written - RingSize / 2;
+		_havePrevious = false;
+	}
+
+	size_t count = 0;
+	while (_read != written && count < maxIntervals)
+	{
+		const uint32_t stamp = _ring[_read % RingSize];
+		_read++;
+		if (_havePrevious)
+			intervals[count++] = intervalCycles(_previous, stamp);
+		_previous = stamp;
+		_havePrevious = true;
+	}
+	return count;
+}
+
+/*!
+	@brief Drop the edges captured since the last call unread
+	@note For when the edges are counted elsewhere, keeps the DMA running.
+		The next interval read starts at the first edge after the call.
+*/
+void PulseCapture::discard(void)
+{
+	if (_dma < 0) return;
+	_read = writtenCount();
+	_havePrevious = false;
+}
+
+/*!
+	@brief Edges captured since the previous call, read or not
+	@param elapsedUs set to the microseconds since the previous call
+	@return falling edges in that time, 0 before begin
+	@note Counts the timestamps DMA wrote, so edges are counted on any pin
+		while readIntervals or discard drain the ring. The count and the
+		time are read with interrupts masked so they belong to the same instant.
+*/
+uint32_t PulseCapture::sample(uint32_t& elapsedUs)
+{
+	if (_dma < 0)
+	{
+		elapsedUs = 0;
+		return 0;
+	}
+	const uint32_t status = save_and_disable_interrupts();
+	const uint32_t written = writtenCount();
+	const uint32_t now = time_us_32();
+	restore_interrupts(status);
+
+	const uint32_t edges = written - _sampleCount;
+	elapsedUs = now - _sampleTime;
+	_sampleCount = written;
+	_sampleTime = now;
+	return edges;
+}
+
+/*!
+	@brief Rate of the intervals returned by readIntervals, the system clock
+*/
+uint32_t PulseCapture::tickHz(void) const
+{
+	return clock_get_hz(clk_sys);
+}
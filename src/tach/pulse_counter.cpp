@@ -0,0 +1,63 @@
+/*!
+* @file pulse_counter.cpp
+* @brief Tachometer. Hall sensor edges counted by a PWM slice source file
+*/
+
+#include "hardware/gpio.h"
+#include "hardware/pwm.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "../../include/tach/pulse_counter.hpp"
+
+/*!
+	@brief Start counting falling edges of a pin in its PWM slice
+	@param pin GPIO of the sensor, set up as an input with its pull beforehand
+	@return false if the pin is not the B channel of a slice
+	@note The pin is switched to the PWM function, its input stays readable
+		by the GPIO interrupt and PIO.
+*/
+bool PulseCounter::begin(uint pin)
+{
+	if (pwm_gpio_to_channel(pin) != PWM_CHAN_B) return false;
+	_slice = pwm_gpio_to_slice_num(pin);
+
+	pwm_config config = pwm_get_default_config();
+	pwm_config_set_clkdiv_mode(&config, PWM_DIV_B_FALLING);
+	pwm_config_set_clkdiv_int(&config, 1);
+	pwm_init(_slice, &config, false);
+	gpio_set_function(pin, GPIO_FUNC_PWM);
+	pwm_set_counter(_slice, 0);
+
+	_lastCount = 0;
+	_lastTime = time_us_32();
+	pwm_set_enabled(_slice, true);
+	_running = true;
+	return true;
+}
+
+/*!
+	@brief Edges counted since the previous call
+	@param elapsedUs set to the microseconds since the previous call
+	@return falling edges in that time, 0 before begin
+	@note The counter is 16 bits wide, call at least every 65535 edges,
+		650 ms at 100k edges per second. The counter and the time are read
+		with interrupts masked so they belong to the same instant.
+*/
+uint32_t PulseCounter::sample(uint32_t& elapsedUs)
+{
+	if (!_running)
+	{
+		elapsedUs = 0;
+		return 0;
+	}
+	const uint32_t status = save_and_disable_interrupts();
+	const uint16_t count = static_cast<uint16_t>(pwm_get_counter(_slice));
+	const uint32_t now = time_us_32();
+	restore_interrupts(status);
+
+	const uint16_t edges = count - _lastCount;
+	elapsedUs = now - _lastTime;
+	_lastCount = count;
+	_lastTime = now;
+	return edges;
+}
@@ -0,0 +1,50 @@
+/*!
+	@file bench.hpp
+	@brief Host benchmark helpers shared by the bench_ programs.
+	@details Host timings only rank the alternatives, the RP2040 runs from
+		flash without a data cache so absolute numbers there differ.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+namespace Bench {
+
+/*! @brief Keeps a result alive so the optimiser cannot drop the work producing it */
+template <class T>
+inline void keep(const T& value)
+{
+	asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/*!
+	@brief Time a function
+	@param calls number of times fn runs
+	@param fn work measured
+	@return nanoseconds per call, the best of three runs
+*/
+template <class Fn>
+double nsPerCall(uint32_t calls, Fn fn)
+{
+	double best = 0.0;
+	for (int run = 0; run < 3; run++)
+	{
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < calls; i++) fn();
+		const auto stop = std::chrono::steady_clock::now();
+		const double ns = std::chrono::duration<double, std::nano>(stop - start).count() / calls;
+		if (run == 0 || ns < best) best = ns;
+	}
+	return best;
+}
+
+/*! @brief Print one result row, name, time per call and the ratio to a reference time */
+inline void report(const char* name, double ns, double referenceNs)
+{
+	printf("  %-36s %10.1f ns  x%.2f\n", name, ns, ns / referenceNs);
+}
+
+} // namespace Bench
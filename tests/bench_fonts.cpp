@@ -0,0 +1,99 @@
+/*!
+	@file bench_fonts.cpp
+	@brief Host benchmark, run length encoded fonts against the raw format.
+	@details Flash size of every bundled font in raw and RLE layout, then the
+		time to draw every glyph of the sixteen segment font in each layout.
+		Fails if the RLE glyphs do not draw the same pixels as the raw ones.
+*/
+
+#include <cstring>
+#include <vector>
+#include "ssd1306/SSD1306_OLED.hpp"
+#include "ssd1306/SSD1306_OLED_font_tools.hpp"
+#include "bench.hpp"
+
+static uint8_t screenBuffer[128 * (64 / 8)];
+
+static std::vector<uint8_t> rleCopy(std::span<const uint8_t> raw)
+{
+	std::vector<uint8_t> font(FontTools::rleFontSize(raw));
+	FontTools::writeFont(raw, SSD1306_OLEDFonts::FontFormatRLE, 1, font.data());
+	return font;
+}
+
+static void sizeRow(const char* name, std::span<const uint8_t> raw)
+{
+	const size_t rle = FontTools::rleFontSize(raw);
+	printf("  %-20s %6zu %6zu  %5.1f%%\n", name, raw.size(), rle, (100.0 * rle) / raw.size());
+}
+
+/*! @brief Draw every glyph of the active font once, one screen position per glyph */
+static void drawAll(SSD1306& oled, const char* text)
+{
+	for (int16_t i = 0; text[i] != '\0'; i++)
+		oled.writeChar(static_cast<int16_t>((i % 4) * 32), static_cast<int16_t>((i / 4) % 2 * 16), text[i]);
+}
+
+int main()
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, screenBuffer);
+
+	printf("Flash size, bytes   raw    RLE  RLE/raw\n");
+	sizeRow("pFontDefault", pFontDefault);
+	sizeRow("pFontWide", pFontWide);
+	sizeRow("pFontSixteenSeg", pFontSixteenSeg);
+	printf("  %-20s %6s %6zu\n", "pFontSixteenSegProp", "-", pFontSixteenSegProp.size());
+
+	const char* digits = "0123456789:.-";
+	const std::vector<uint8_t> wideRLE = rleCopy(pFontWide);
+	const char* upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789";
+	struct Case { const char* name; std::span<const uint8_t> font; const char* text; };
+	const Case cases[] = {
+		{"pFontSixteenSeg raw", pFontSixteenSeg, digits},
+		{"pFontSixteenSegRLE", pFontSixteenSegRLE, digits},
+		{"pFontWide raw", pFontWide, upper},
+		{"pFontWide RLE", wideRLE, upper},
+	};
+
+	// same pixels from both layouts before timing them
+	uint8_t reference[sizeof(screenBuffer)];
+	for (size_t c = 0; c < std::size(cases); c += 2)
+	{
+		for (uint8_t scale = 1; scale <= 2; scale++)
+		{
+			oled.setTextScale(scale);
+			oled.setFont(cases[c].font);
+			oled.OLEDclearBuffer();
+			drawAll(oled, cases[c].text);
+			memcpy(reference, screenBuffer, sizeof(screenBuffer));
+			oled.setFont(cases[c + 1].font);
+			oled.OLEDclearBuffer();
+			drawAll(oled, cases[c + 1].text);
+			if (memcmp(reference, screenBuffer, sizeof(screenBuffer)) != 0)
+			{
+				printf("FAIL %s draws differently from %s at scale %u\n", cases[c + 1].name, cases[c].name, scale);
+				return 1;
+			}
+		}
+	}
+
+	for (uint8_t scale = 1; scale <= 2; scale++)
+	{
+		printf("Draw every glyph, scale %u\n", scale);
+		oled.setTextScale(scale);
+		for (size_t c = 0; c < std::size(cases); c += 2)
+		{
+			double rawNs = 0.0;
+			for (size_t k = c; k < c + 2; k++)
+			{
+				oled.setFont(cases[k].font);
+				const double ns = Bench::nsPerCall(2000, [&] { drawAll(oled, cases[k].text); });
+				if (k == c) rawNs = ns;
+				Bench::report(cases[k].name, ns, rawNs);
+			}
+		}
+	}
+	Bench::keep(screenBuffer);
+	return 0;
+}
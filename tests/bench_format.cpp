@@ -0,0 +1,122 @@
+/*!
+	@file bench_format.cpp
+	@brief Host benchmark, fixed point number text against the float paths it replaced.
+	@details Times one decimal readings such as an RPM turned into text by
+		-# Print::print(double), now scaled once and written by formatFixed
+		-# the previous printFloat, a double multiply and cast per digit
+		-# snprintf "%.1f"
+		-# FixedFormat::formatFixed of a value already held scaled, as main.cpp does
+		The host has a double FPU, so the float paths look cheaper here than
+		on the RP2040, where every double operation is a library call. Fails
+		if print(double) and snprintf disagree on values away from a rounding tie.
+*/
+
+#include <cstring>
+#include "ssd1306/SSD1306_OLED_Print.hpp"
+#include "ssd1306/SSD1306_OLED_format.hpp"
+#include "bench.hpp"
+
+/*! @brief Print target collecting the text in a buffer */
+class TextPrint : public Print
+{
+  public:
+	size_t write(uint8_t c) override
+	{
+		if (_length + 1 < sizeof(_text)) _text[_length++] = static_cast<char>(c);
+		_text[_length] = '\0';
+		return 1;
+	}
+	using Print::write;
+	void clear(void) { _length = 0; _text[0] = '\0'; }
+	const char* text(void) const { return _text; }
+
+  private:
+	char _text[48] = {};
+	size_t _length = 0;
+};
+
+/*! @brief printFloat as it was, one double multiply and cast per fraction digit */
+static size_t previousPrintFloat(Print& out, double number, uint8_t digits)
+{
+	size_t n = 0;
+	if (std::isnan(number)) return out.print("nan");
+	if (std::isinf(number)) return out.print("inf");
+	if (number > 4294967040.0) return out.print("ovf");
+	if (number < -4294967040.0) return out.print("ovf");
+	if (number < 0.0)
+	{
+		n += out.print('-');
+		number = -number;
+	}
+	double rounding = 0.5;
+	for (uint8_t i = 0; i < digits; ++i)
+		rounding /= 10.0;
+	number += rounding;
+	unsigned long int_part = static_cast<unsigned long>(number);
+	double remainder = number - static_cast<double>(int_part);
+	n += out.print(int_part);
+	if (digits > 0) n += out.print('.');
+	while (digits-- > 0)
+	{
+		remainder *= 10.0;
+		unsigned int toPrint = static_cast<unsigned int>(remainder);
+		n += out.print(toPrint);
+		remainder -= toPrint;
+	}
+	return n;
+}
+
+static constexpr size_t Readings = 256;
+
+int main()
+{
+	// tachometer readings, tenths of an RPM, never on a .x5 tie
+	double values[Readings];
+	int32_t scaled[Readings];
+	for (size_t i = 0; i < Readings; i++)
+	{
+		scaled[i] = static_cast<int32_t>((i * 7919) % 300000);
+		values[i] = (scaled[i] / 10.0) + 0.01;
+	}
+
+	TextPrint out;
+	char expected[32];
+	for (size_t i = 0; i < Readings; i++)
+	{
+		out.clear();
+		out.print(values[i], 1);
+		snprintf(expected, sizeof(expected), "%.1f", values[i]);
+		if (strcmp(out.text(), expected) != 0)
+		{
+			printf("FAIL print(%f, 1) wrote \"%s\", snprintf \"%s\"\n", values[i], out.text(), expected);
+			return 1;
+		}
+	}
+
+	printf("One decimal readings to text, %zu values\n", Readings);
+	size_t i = 0;
+	const double printNs = Bench::nsPerCall(200000, [&] {
+		out.clear();
+		out.print(values[i++ % Readings], 1);
+	});
+	Bench::report("print(double), formatFixed", printNs, printNs);
+	Bench::report("previous printFloat", Bench::nsPerCall(200000, [&] {
+		out.clear();
+		previousPrintFloat(out, values[i++ % Readings], 1);
+	}), printNs);
+	char text[32];
+	Bench::report("snprintf \"%.1f\"", Bench::nsPerCall(200000, [&] {
+		snprintf(text, sizeof(text), "%.1f", values[i++ % Readings]);
+		Bench::keep(text);
+	}), printNs);
+	Bench::report("formatFixed of a scaled value", Bench::nsPerCall(200000, [&] {
+		FixedFormat::formatFixed(text, sizeof(text), scaled[i++ % Readings], 0, 1);
+		Bench::keep(text);
+	}), printNs);
+	Bench::report("toFixed + formatFixed of a float", Bench::nsPerCall(200000, [&] {
+		FixedFormat::formatFixed(text, sizeof(text),
+			FixedFormat::toFixed(static_cast<float>(values[i++ % Readings]), 1), 0, 1);
+		Bench::keep(text);
+	}), printNs);
+	return 0;
+}
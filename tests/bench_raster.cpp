@@ -0,0 +1,85 @@
+/*!
+	@file bench_raster.cpp
+	@brief Host benchmark, raster algorithms on the page buffer against virtual drawPixel.
+	@details Each Raster algorithm runs once instantiated for SSD1306_PageBuffer,
+		the path render() takes at rotation 0, and once for a target that sends
+		every pixel through the virtual drawPixel, the path taken when rotated.
+		Fails if the two targets draw different pixels.
+*/
+
+#include <cstring>
+#include "ssd1306/SSD1306_OLED.hpp"
+#include "ssd1306/SSD1306_OLED_raster.hpp"
+#include "bench.hpp"
+
+static uint8_t pageBuffer[128 * (64 / 8)];
+static uint8_t pixelBuffer[128 * (64 / 8)];
+
+/*! @brief Target forwarding each pixel to the virtual drawPixel, as render() does when rotated */
+struct VirtualTarget {
+	SSD1306_graphics& gfx; /**< display drawn to */
+	inline void plot(int16_t x, int16_t y, uint8_t color) { gfx.drawPixel(x, y, color); }
+	inline void vspan(int16_t x, int16_t y0, int16_t y1, uint8_t color) {
+		for (int16_t y = y0; y <= y1; y++) gfx.drawPixel(x, y, color);
+	}
+	inline void hspan(int16_t x0, int16_t x1, int16_t y, uint8_t color) {
+		for (int16_t x = x0; x <= x1; x++) gfx.drawPixel(x, y, color);
+	}
+};
+
+/*! @brief One shape drawn by a Raster algorithm into any target */
+struct Shape {
+	const char* name;
+	void (*drawPage)(SSD1306_PageBuffer&, const ClipRect&);
+	void (*drawPixel)(VirtualTarget&, const ClipRect&);
+};
+
+#define SHAPE(label, call) {label, \
+	[](SSD1306_PageBuffer& t, const ClipRect& clip) { call; }, \
+	[](VirtualTarget& t, const ClipRect& clip) { call; }}
+
+static const Shape shapes[] = {
+	SHAPE("line, shallow", Raster::line(t, clip, 0, 5, 127, 58, 2)),
+	SHAPE("line, steep", Raster::line(t, clip, 20, 0, 40, 63, 2)),
+	SHAPE("fillRect 100x40", Raster::fillRect(t, clip, 10, 10, 100, 40, 2)),
+	SHAPE("circle r=30", Raster::circle(t, clip, 64, 32, 30, 2)),
+	SHAPE("fillCircle halves r=30", Raster::fillCircleHalves(t, clip, 64, 32, 30, 3, 0, 2)),
+	SHAPE("fillTriangle", Raster::fillTriangle(t, clip, 5, 60, 64, 2, 122, 45, 2)),
+};
+
+int main()
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, pixelBuffer);
+	SSD1306_PageBuffer page(pageBuffer, 128, 64);
+	VirtualTarget pixels{oled};
+	const ClipRect clip{0, 0, 128, 64};
+
+	for (const Shape& shape : shapes)
+	{
+		memset(pageBuffer, 0, sizeof(pageBuffer));
+		memset(pixelBuffer, 0, sizeof(pixelBuffer));
+		shape.drawPage(page, clip);
+		shape.drawPixel(pixels, clip);
+		if (memcmp(pageBuffer, pixelBuffer, sizeof(pageBuffer)) != 0)
+		{
+			printf("FAIL %s draws differently on the two targets\n", shape.name);
+			return 1;
+		}
+	}
+
+	printf("Raster algorithms, page buffer target against virtual drawPixel\n");
+	for (const Shape& shape : shapes)
+	{
+		const double pixelNs = Bench::nsPerCall(2000, [&] { shape.drawPixel(pixels, clip); });
+		const double pageNs = Bench::nsPerCall(2000, [&] { shape.drawPage(page, clip); });
+		char name[64];
+		snprintf(name, sizeof(name), "%s, drawPixel", shape.name);
+		Bench::report(name, pixelNs, pixelNs);
+		snprintf(name, sizeof(name), "%s, page buffer", shape.name);
+		Bench::report(name, pageNs, pixelNs);
+	}
+	Bench::keep(pageBuffer);
+	Bench::keep(pixelBuffer);
+	return 0;
+}
@@ -0,0 +1,74 @@
+/*!
+	@file bench_segments.cpp
+	@brief Host benchmark, drawSegmentNumber against text in the sixteen segment font.
+	@details Times a four character reading drawn as seven segment digits and
+		as pFontSixteenSeg glyphs of the same 48 pixel height, then the segment
+		digits at other heights, which the font cannot draw without scaling.
+		Fails if a reading does not draw or the segment digits reach past
+		measureSegmentNumber.
+*/
+
+#include "ssd1306/SSD1306_OLED.hpp"
+#include "bench.hpp"
+
+static uint8_t screenBuffer[128 * (64 / 8)];
+
+/*! @brief true if no pixel at or right of column x is set */
+static bool blankFrom(int16_t x)
+{
+	for (int16_t col = x; col < 128; col++)
+		for (int16_t page = 0; page < 8; page++)
+			if (screenBuffer[(page * 128) + col] != 0x00) return false;
+	return true;
+}
+
+int main()
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, screenBuffer);
+	const char* reading = "12.5";
+
+	for (int16_t h : {16, 32, 48, 64})
+	{
+		oled.OLEDclearBuffer();
+		if (oled.drawSegmentNumber(0, 0, h, reading, 1) != DisplayRet::Success)
+		{
+			printf("FAIL drawSegmentNumber height %d\n", h);
+			return 1;
+		}
+		const int16_t width = oled.measureSegmentNumber(h, reading);
+		if (width <= 128 && !blankFrom(width))
+		{
+			printf("FAIL drawSegmentNumber height %d draws past its measured width %d\n", h, width);
+			return 1;
+		}
+	}
+
+	printf("Flash, font table bytes: pFontSixteenSeg %zu, pFontSixteenSegRLE %zu, segment masks 12\n",
+		pFontSixteenSeg.size(), pFontSixteenSegRLE.size());
+	printf("Draw \"%s\", 48 pixels high\n", reading);
+	oled.setFont(pFontSixteenSeg);
+	const double fontNs = Bench::nsPerCall(20000, [&] { oled.drawText(0, 8, reading); });
+	Bench::report("drawText pFontSixteenSeg", fontNs, fontNs);
+	oled.setFont(pFontSixteenSegRLE);
+	Bench::report("drawText pFontSixteenSegRLE",
+		Bench::nsPerCall(20000, [&] { oled.drawText(0, 8, reading); }), fontNs);
+	oled.OLEDclearBuffer();
+	Bench::report("drawSegmentNumber",
+		Bench::nsPerCall(20000, [&] { oled.drawSegmentNumber(0, 8, 48, reading, 1); }), fontNs);
+	Bench::report("fillRect clear + drawSegmentNumber",
+		Bench::nsPerCall(20000, [&] {
+			oled.fillRect(0, 8, oled.measureSegmentNumber(48, reading), 48, 0);
+			oled.drawSegmentNumber(0, 8, 48, reading, 1);
+		}), fontNs);
+
+	printf("drawSegmentNumber at other heights\n");
+	for (int16_t h : {16, 32, 64})
+	{
+		char name[32];
+		snprintf(name, sizeof(name), "drawSegmentNumber h=%d", h);
+		Bench::report(name, Bench::nsPerCall(20000, [&] { oled.drawSegmentNumber(0, 0, h, reading, 1); }), fontNs);
+	}
+	Bench::keep(screenBuffer);
+	return 0;
+}
@@ -0,0 +1,12 @@
+/*!
+	@file clocks.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+enum clock_index { clk_sys = 5 };
+
+inline uint32_t clock_get_hz(clock_index) { return 125000000; }
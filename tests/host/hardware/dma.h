@@ -0,0 +1,36 @@
+/*!
+	@file dma.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+	@note One channel exists, it moves a word only when the test hands it
+		one, see HostSdk::DmaChannel.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+struct dma_channel_hw_t {
+	volatile uint32_t read_addr;
+	volatile uint32_t write_addr;
+	volatile uint32_t transfer_count;
+	volatile uint32_t ctrl_trig;
+};
+
+struct dma_channel_config {
+	uint8_t ringBits;  /**< write address wraps on 2^ringBits bytes, 0 no ring */
+};
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+int dma_claim_unused_channel(bool required);
+inline dma_channel_config dma_channel_get_default_config(uint) { return dma_channel_config{0}; }
+inline void channel_config_set_transfer_data_size(dma_channel_config*, dma_channel_transfer_size) {}
+inline void channel_config_set_read_increment(dma_channel_config*, bool) {}
+inline void channel_config_set_write_increment(dma_channel_config*, bool) {}
+inline void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits) { if (write) c->ringBits = size_bits; }
+inline void channel_config_set_dreq(dma_channel_config*, uint) {}
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+	const volatile void* read_addr, uint transfer_count, bool trigger);
+dma_channel_hw_t* dma_channel_hw_addr(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_channel_set_trans_count(uint channel, uint32_t trans_count, bool trigger);
@@ -0,0 +1,13 @@
+/*!
+	@file gpio.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+enum gpio_function { GPIO_FUNC_I2C = 3, GPIO_FUNC_PWM = 4, GPIO_FUNC_NULL = 0x1f };
+
+inline void gpio_set_function(uint, gpio_function) {}
+inline void gpio_pull_up(uint) {}
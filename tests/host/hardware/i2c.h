@@ -0,0 +1,19 @@
+/*!
+	@file i2c.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+	@note Writes land in the controller emulator of host_sdk.hpp.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+struct i2c_inst { int unused; };
+typedef struct i2c_inst i2c_inst_t;
+extern i2c_inst_t* i2c0;
+extern i2c_inst_t* i2c1;
+
+inline uint i2c_init(i2c_inst_t*, uint baudrate) { return baudrate; }
+inline void i2c_deinit(i2c_inst_t*) {}
+int i2c_write_timeout_us(i2c_inst_t* i2c, uint8_t addr, const uint8_t* src, size_t len, bool nostop, uint timeout_us);
+int i2c_read_timeout_us(i2c_inst_t* i2c, uint8_t addr, uint8_t* dst, size_t len, bool nostop, uint timeout_us);
@@ -0,0 +1,36 @@
+/*!
+	@file pio.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+	@note Programs and state machines are accepted and do nothing, the
+		values a state machine would push are fed to the DMA stand-in by
+		the test, see host_sdk.hpp.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+struct pio_hw_t { volatile uint32_t rxf[4]; };
+typedef pio_hw_t* PIO;
+extern PIO pio0;
+extern PIO pio1;
+
+struct pio_program_t { const uint16_t* instructions; uint8_t length; int8_t origin; };
+struct pio_sm_config { uint32_t unused; };
+enum pio_fifo_join { PIO_FIFO_JOIN_NONE = 0, PIO_FIFO_JOIN_TX = 1, PIO_FIFO_JOIN_RX = 2 };
+enum pio_src_dest { pio_x = 1, pio_null = 3 };
+
+inline bool pio_can_add_program(PIO, const pio_program_t*) { return true; }
+inline uint pio_add_program(PIO, const pio_program_t*) { return 0; }
+inline int pio_claim_unused_sm(PIO, bool) { return 0; }
+inline void pio_sm_unclaim(PIO, uint) {}
+inline uint pio_get_dreq(PIO, uint sm, bool is_tx) { return (is_tx ? 0 : 4) + sm; }
+inline void pio_sm_set_enabled(PIO, uint, bool) {}
+inline pio_sm_config pio_get_default_sm_config(void) { return pio_sm_config{}; }
+inline void sm_config_set_jmp_pin(pio_sm_config*, uint) {}
+inline void sm_config_set_in_shift(pio_sm_config*, bool, bool, uint) {}
+inline void sm_config_set_fifo_join(pio_sm_config*, pio_fifo_join) {}
+inline int pio_sm_set_consecutive_pindirs(PIO, uint, uint, uint, bool) { return 0; }
+inline int pio_sm_init(PIO, uint, uint, const pio_sm_config*) { return 0; }
+inline void pio_sm_exec(PIO, uint, uint) {}
+inline uint pio_encode_mov_not(pio_src_dest, pio_src_dest) { return 0; }
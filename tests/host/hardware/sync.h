@@ -0,0 +1,13 @@
+/*!
+	@file sync.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+*/
+
+#pragma once
+
+#include <atomic>
+#include "pico/types.h"
+
+inline void __dmb(void) { std::atomic_thread_fence(std::memory_order_seq_cst); }
+inline uint32_t save_and_disable_interrupts(void) { return 0; }
+inline void restore_interrupts(uint32_t) {}
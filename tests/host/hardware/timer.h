@@ -0,0 +1,12 @@
+/*!
+	@file timer.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+	@note Time only moves when a test sets it, see host_sdk.hpp.
+*/
+
+#pragma once
+
+#include "pico/types.h"
+
+uint32_t time_us_32(void);
+inline void busy_wait_ms(uint32_t) {}
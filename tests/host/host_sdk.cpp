@@ -0,0 +1,160 @@
+/*!
+	@file host_sdk.cpp
+	@brief Host test definitions of the Pico SDK calls the stand-in headers declare.
+*/
+
+#include "hardware/dma.h"
+#include "hardware/i2c.h"
+#include "hardware/pio.h"
+#include "hardware/timer.h"
+#include "host_sdk.hpp"
+
+namespace HostSdk {
+
+uint32_t timeUs = 0;
+size_t i2cBytes = 0;
+Gddram gddram;
+DmaChannel dma;
+
+/*! @brief Argument bytes following a command byte */
+static uint8_t commandArguments(uint8_t command)
+{
+	switch (command)
+	{
+		case 0x21: case 0x22: case 0xA3: return 2;
+		case 0x29: case 0x2A: return 5;
+		case 0x26: case 0x27: return 6;
+		case 0x20: case 0x81: case 0x8D: case 0xA8: case 0xD3:
+		case 0xD5: case 0xD9: case 0xDA: case 0xDB: return 1;
+		default: return 0;
+	}
+}
+
+void Gddram::writeCommand(uint8_t value)
+{
+	if (argsPending == 0)
+	{
+		command = value;
+		argsPending = commandArguments(value);
+		argsSeen = 0;
+		return;
+	}
+	if (command == 0x21)
+	{
+		if (argsSeen == 0) colStart = value & 0x7F;
+		else colEnd = value & 0x7F;
+		col = colStart;
+	} else if (command == 0x22)
+	{
+		if (argsSeen == 0) pageStart = value & 0x07;
+		else pageEnd = value & 0x07;
+		page = pageStart;
+	}
+	argsSeen++;
+	argsPending--;
+}
+
+void Gddram::writeData(uint8_t value)
+{
+	ram[page][col] = value;
+	if (col++ == colEnd)
+	{
+		col = colStart;
+		if (page++ == pageEnd) page = pageStart;
+	}
+}
+
+/*!
+	@brief One transfer, as on a DREQ from the state machine
+	@param value word the state machine pushed
+	@return false if the run had ended and the word was dropped
+*/
+bool DmaChannel::push(uint32_t value)
+{
+	if (!busy) return false;
+	ring[index] = value;
+	skip(1);
+	return true;
+}
+
+/*!
+	@brief Account for transfers without writing them
+	@param transfers transfers done, at most the remaining count
+	@note Stands in for runs far longer than a test can push one by one.
+*/
+void DmaChannel::skip(uint32_t transfers)
+{
+	index = ringWords ? (index + transfers) % ringWords : index + transfers;
+	hw.transfer_count = hw.transfer_count - transfers;
+	if (hw.transfer_count == 0) busy = false;
+}
+
+} // namespace HostSdk
+
+static pio_hw_t hostPio[2];
+PIO pio0 = &hostPio[0];
+PIO pio1 = &hostPio[1];
+
+int dma_claim_unused_channel(bool)
+{
+	if (HostSdk::dma.claimed) return -1;
+	HostSdk::dma.claimed = true;
+	return 0;
+}
+
+void dma_channel_configure(uint, const dma_channel_config* config, volatile void* write_addr,
+	const volatile void*, uint transfer_count, bool trigger)
+{
+	HostSdk::DmaChannel& dma = HostSdk::dma;
+	dma.ring = static_cast<volatile uint32_t*>(write_addr);
+	dma.ringWords = config->ringBits ? (1u << config->ringBits) / sizeof(uint32_t) : 0;
+	dma.index = 0;
+	dma.hw.transfer_count = transfer_count;
+	dma.busy = trigger && transfer_count != 0;
+}
+
+dma_channel_hw_t* dma_channel_hw_addr(uint)
+{
+	return &HostSdk::dma.hw;
+}
+
+bool dma_channel_is_busy(uint)
+{
+	return HostSdk::dma.busy;
+}
+
+void dma_channel_set_trans_count(uint, uint32_t trans_count, bool trigger)
+{
+	HostSdk::dma.hw.transfer_count = trans_count;
+	if (trigger) HostSdk::dma.busy = trans_count != 0;
+}
+
+static i2c_inst_t hostI2c[2];
+i2c_inst_t* i2c0 = &hostI2c[0];
+i2c_inst_t* i2c1 = &hostI2c[1];
+
+uint32_t time_us_32(void)
+{
+	return HostSdk::timeUs;
+}
+
+/*!
+	@note The first byte is the SSD1306 control byte, 0x00 commands follow,
+		0x40 display data follows.
+*/
+int i2c_write_timeout_us(i2c_inst_t*, uint8_t, const uint8_t* src, size_t len, bool, uint)
+{
+	HostSdk::i2cBytes += len;
+	for (size_t i = 1; i < len; i++)
+	{
+		if (src[0] == 0x40) HostSdk::gddram.writeData(src[i]);
+		else HostSdk::gddram.writeCommand(src[i]);
+	}
+	return static_cast<int>(len);
+}
+
+int i2c_read_timeout_us(i2c_inst_t*, uint8_t, uint8_t* dst, size_t len, bool, uint)
+{
+	for (size_t i = 0; i < len; i++) dst[i] = 0x00;
+	return static_cast<int>(len);
+}
@@ -0,0 +1,63 @@
+/*!
+	@file host_sdk.hpp
+	@brief Host test state behind the Pico SDK stand-ins in tests/host.
+	@details The stand-in headers declare the SDK calls the library and the
+		tachometer sources make, host_sdk.cpp defines them. Tests set and
+		read the state here instead of talking to hardware.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include "hardware/dma.h"
+
+namespace HostSdk {
+
+/*!
+	@brief SSD1306 display RAM as horizontal addressing mode fills it
+	@details Commands select the column and page window, data bytes are
+		stored at the column and page pointers which wrap inside the window,
+		as the controller does. Other commands are parsed for their argument
+		count only.
+*/
+struct Gddram {
+	uint8_t ram[8][128] = {}; /**< page, column */
+	uint8_t colStart = 0;     /**< column window set by 0x21 */
+	uint8_t colEnd = 127;
+	uint8_t pageStart = 0;    /**< page window set by 0x22 */
+	uint8_t pageEnd = 7;
+	uint8_t col = 0;          /**< next column written */
+	uint8_t page = 0;         /**< next page written */
+	uint8_t command = 0;      /**< command still taking arguments */
+	uint8_t argsPending = 0;  /**< arguments of command still to come */
+	uint8_t argsSeen = 0;     /**< arguments of command received */
+
+	void writeCommand(uint8_t value);
+	void writeData(uint8_t value);
+};
+
+/*!
+	@brief The one DMA channel, moving words only when the test pushes them
+	@details Stands for a PIO state machine pushing into its RX FIFO and the
+		channel copying each push to its write ring. A push while the run
+		has ended is lost, as the FIFO would overflow without a restart.
+*/
+struct DmaChannel {
+	bool claimed = false;               /**< handed out by dma_claim_unused_channel */
+	volatile uint32_t* ring = nullptr;  /**< write address at configure */
+	uint32_t ringWords = 0;             /**< write ring size in words, 0 no ring */
+	uint32_t index = 0;                 /**< next word written, from ring */
+	bool busy = false;                  /**< run in progress */
+	dma_channel_hw_t hw{};              /**< registers the driver reads */
+
+	bool push(uint32_t value);
+	void skip(uint32_t transfers);
+};
+
+extern uint32_t timeUs;   /**< value time_us_32 returns, moved by the test */
+extern size_t i2cBytes;   /**< bytes written over I2C, control bytes included */
+extern Gddram gddram;     /**< display RAM of the one display on the bus */
+extern DmaChannel dma;    /**< the one DMA channel */
+
+} // namespace HostSdk
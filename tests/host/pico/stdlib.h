@@ -0,0 +1,12 @@
+/*!
+	@file stdlib.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+*/
+
+#pragma once
+
+#include <cstdio>
+#include "pico/types.h"
+#include "hardware/gpio.h"
+#include "hardware/i2c.h"
+#include "hardware/timer.h"
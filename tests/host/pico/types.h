@@ -0,0 +1,11 @@
+/*!
+	@file types.h
+	@brief Host stand-in for the Pico SDK header of the same name, tests only.
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+typedef unsigned int uint;
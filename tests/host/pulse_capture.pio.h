@@ -0,0 +1,19 @@
+/*!
+	@file pulse_capture.pio.h
+	@brief Host stand-in for the header pioasm generates from src/tach/pulse_capture.pio, tests only.
+*/
+
+#pragma once
+
+#include "hardware/pio.h"
+
+static const uint pulse_capture_offset_low = 4u;
+static const uint16_t pulse_capture_program_instructions[6] = {};
+static const struct pio_program_t pulse_capture_program = { pulse_capture_program_instructions, 6, -1 };
+
+static inline void pulse_capture_program_init(PIO pio, uint sm, uint offset, uint pin)
+{
+	pio_sm_config c = pio_get_default_sm_config();
+	sm_config_set_jmp_pin(&c, pin);
+	pio_sm_init(pio, sm, offset + pulse_capture_offset_low, &c);
+}
@@ -0,0 +1,115 @@
+/*!
+	@file test_bitmap.cpp
+	@brief Host test, OLEDBitmap and OLEDBitmapVertical against drawPixel.
+	@details Random bitmaps of both layouts are drawn at page aligned and
+		unaligned y, hanging off every edge of the screen, with and without a
+		clip rectangle, inverted or not. The reference sets each bitmap pixel
+		with drawPixel, the path rotated displays still take, and the two
+		buffers must match byte for byte:
+		-# OLEDBitmap, 8x8 block transpose and masked column writes
+		-# OLEDBitmapVertical, straight page copy when y is page aligned and
+			the page is inside the clip, masked column writes otherwise
+*/
+
+#include <cstring>
+#include <vector>
+#include "ssd1306/SSD1306_OLED.hpp"
+
+static uint8_t bitmapBuffer[128 * (64 / 8)];
+static uint8_t referenceBuffer[128 * (64 / 8)];
+static SSD1306 oled(128, 64);
+static SSD1306 reference(128, 64);
+static int failures = 0;
+static long bitmapsDrawn = 0;
+
+/*! @brief Small deterministic generator, a failing case can be replayed */
+struct Random {
+	uint32_t state;
+	int16_t next(int16_t range, int16_t offset = 0) {
+		state = (state * 1103515245u) + 12345u;
+		return static_cast<int16_t>(((state >> 16) % range) + offset);
+	}
+};
+
+/*! @brief Both buffers start from the same random background */
+static void fillBackground(Random& rnd)
+{
+	for (size_t i = 0; i < sizeof(bitmapBuffer); i++)
+		bitmapBuffer[i] = referenceBuffer[i] = static_cast<uint8_t>(rnd.next(256));
+}
+
+static void compare(const char* path, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool clipped,
+	DisplayRet::Ret_Codes_e drawn)
+{
+	bitmapsDrawn++;
+	if ((drawn != DisplayRet::Success || memcmp(bitmapBuffer, referenceBuffer, sizeof(bitmapBuffer)) != 0)
+		&& failures++ < 10)
+	{
+		printf("FAIL %s %dx%d at (%d,%d)%s%s, error %d\n", path, w, h, x, y,
+			invert ? " inverted" : "", clipped ? " clipped" : "", drawn);
+	}
+}
+
+/*! @brief Row bytes, MSB is the left pixel */
+static void checkHorizontal(Random& rnd, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool clipped)
+{
+	std::vector<uint8_t> bitmap((w / 8) * h);
+	for (uint8_t& b : bitmap) b = static_cast<uint8_t>(rnd.next(256));
+	fillBackground(rnd);
+	const DisplayRet::Ret_Codes_e drawn = oled.OLEDBitmap(x, y, w, h, bitmap, invert);
+	for (int16_t j = 0; j < h; j++)
+		for (int16_t i = 0; i < w; i++)
+		{
+			const bool set = bitmap[(j * (w / 8)) + (i / 8)] & (0x80 >> (i % 8));
+			reference.drawPixel(x + i, y + j, (set != invert) ? SSD1306::WHITE : SSD1306::BLACK);
+		}
+	compare("OLEDBitmap", x, y, w, h, invert, clipped, drawn);
+}
+
+/*! @brief Page column bytes, bit 0 is the top pixel */
+static void checkVertical(Random& rnd, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool clipped)
+{
+	std::vector<uint8_t> bitmap(w * (h / 8));
+	for (uint8_t& b : bitmap) b = static_cast<uint8_t>(rnd.next(256));
+	fillBackground(rnd);
+	const DisplayRet::Ret_Codes_e drawn = oled.OLEDBitmapVertical(x, y, w, h, bitmap, invert);
+	for (int16_t j = 0; j < h; j++)
+		for (int16_t i = 0; i < w; i++)
+		{
+			const bool set = bitmap[((j / 8) * w) + i] & (1 << (j % 8));
+			reference.drawPixel(x + i, y + j, (set != invert) ? SSD1306::WHITE : SSD1306::BLACK);
+		}
+	compare("OLEDBitmapVertical", x, y, w, h, invert, clipped, drawn);
+}
+
+int main()
+{
+	oled.OLEDSetBufferPtr(128, 64, bitmapBuffer);
+	reference.OLEDSetBufferPtr(128, 64, referenceBuffer);
+	Random rnd{2024};
+
+	for (int n = 0; n < 20000; n++)
+	{
+		const bool clipped = (n % 3) == 0;
+		if (clipped)
+		{
+			const int16_t cx = rnd.next(140, -6), cy = rnd.next(80, -6), cw = rnd.next(100), ch = rnd.next(60);
+			oled.setClipRect(cx, cy, cw, ch);
+			reference.setClipRect(cx, cy, cw, ch);
+		} else
+		{
+			oled.resetClip();
+			reference.resetClip();
+		}
+		const bool invert = rnd.next(2);
+		// anywhere from hanging off the top left to hanging off the bottom right
+		const int16_t w = rnd.next(48, 1);
+		const int16_t h = rnd.next(48, 1);
+		const int16_t x = rnd.next(128 + w, -w + 1);
+		const int16_t y = (n % 2) ? static_cast<int16_t>(rnd.next(10, -2) * 8) : rnd.next(64 + h, -h + 1);
+		checkHorizontal(rnd, x, y, ((w + 7) / 8) * 8, h, invert, clipped);
+		checkVertical(rnd, x, y, w, ((h + 7) / 8) * 8, invert, clipped);
+	}
+	if (failures == 0) printf("OLEDBitmap and OLEDBitmapVertical match drawPixel, %ld bitmaps drawn\n", bitmapsDrawn);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,240 @@
+/*!
+	@file test_console.cpp
+	@brief Host test, SSD1306_Console cell model, render and flush.
+	@details A shadow grid in the test follows every write and says which
+		cells must turn dirty, the console has to agree cell for cell:
+		-# writes that do not change a cell leave it clean, cells outside
+			the grid are ignored, printAt cuts text at the row end
+		-# printLine blanks the rest of the row, dirtying only cells that
+			held something else
+		-# render draws the dirty cells to the same pixels as a render of
+			every cell
+		-# flush sends one OLEDupdateRegion per run of dirty cells in a row,
+			counted in I2C bytes, leaves every other column of the display
+			RAM alone and sends nothing the second time
+*/
+
+#include <cstring>
+#include "ssd1306/SSD1306_OLED_console.hpp"
+#include "host_sdk.hpp"
+
+static uint8_t consoleBuffer[128 * (64 / 8)];
+static uint8_t referenceBuffer[128 * (64 / 8)];
+static int failures = 0;
+
+/*! @brief What the test expects the console to hold */
+struct Shadow {
+	char value[SSD1306_Console::Rows][SSD1306_Console::Columns];
+	uint8_t attr[SSD1306_Console::Rows][SSD1306_Console::Columns];
+	bool dirty[SSD1306_Console::Rows][SSD1306_Console::Columns];
+
+	Shadow() {
+		memset(value, ' ', sizeof(value));
+		memset(attr, 0, sizeof(attr));
+		memset(dirty, 0, sizeof(dirty));
+	}
+	void set(uint8_t column, uint8_t row, char c, uint8_t a) {
+		if (column >= SSD1306_Console::Columns || row >= SSD1306_Console::Rows) return;
+		if (value[row][column] == c && attr[row][column] == a) return;
+		value[row][column] = c;
+		attr[row][column] = a;
+		dirty[row][column] = true;
+	}
+	void line(uint8_t row, const char* text, uint8_t a) {
+		uint8_t column = 0;
+		for (; text[column] != '\0' && column < SSD1306_Console::Columns; column++) set(column, row, text[column], a);
+		for (; column < SSD1306_Console::Columns; column++) set(column, row, ' ', a);
+	}
+};
+
+/*! @brief Small deterministic generator, a failing case can be replayed */
+struct Random {
+	uint32_t state;
+	int16_t next(int16_t range, int16_t offset = 0) {
+		state = (state * 1103515245u) + 12345u;
+		return static_cast<int16_t>(((state >> 16) % range) + offset);
+	}
+};
+
+static void checkCells(const SSD1306_Console& console, const Shadow& shadow, const char* phase)
+{
+	for (uint8_t row = 0; row < SSD1306_Console::Rows; row++)
+		for (uint8_t column = 0; column < SSD1306_Console::Columns; column++)
+		{
+			if (console.getChar(column, row) != shadow.value[row][column] && failures++ < 10)
+				printf("FAIL %s: cell %u,%u holds '%c', expected '%c'\n", phase, column, row,
+					console.getChar(column, row), shadow.value[row][column]);
+			if (console.isDirty(column, row) != shadow.dirty[row][column] && failures++ < 10)
+				printf("FAIL %s: cell %u,%u %s dirty\n", phase, column, row, shadow.dirty[row][column] ? "not" : "is");
+		}
+}
+
+/*! @brief I2C bytes of one OLEDupdateRegion one page high: six command bytes each with a control byte, then the data */
+static size_t regionBytes(size_t cells)
+{
+	return (6 * 2) + 1 + (cells * SSD1306_Console::CellWidth);
+}
+
+/*!
+	@brief Render and flush, the display RAM must take exactly the dirty runs
+	@details Display RAM columns outside the runs are poisoned first and
+		must come back untouched, the rest must hold the buffer.
+*/
+static void renderAndFlush(SSD1306_Console& console, Shadow& shadow, const char* phase)
+{
+	size_t expectedBytes = 0;
+	uint8_t expectedCells = 0;
+	bool sent[8][128] = {};
+	for (uint8_t row = 0; row < SSD1306_Console::Rows; row++)
+	{
+		uint8_t column = 0;
+		while (column < SSD1306_Console::Columns)
+		{
+			if (!shadow.dirty[row][column]) { column++; continue; }
+			const uint8_t first = column;
+			while (column < SSD1306_Console::Columns && shadow.dirty[row][column]) column++;
+			expectedBytes += regionBytes(column - first);
+			expectedCells += column - first;
+			for (int x = first * SSD1306_Console::CellWidth; x < column * SSD1306_Console::CellWidth; x++)
+				sent[row][x] = true;
+		}
+	}
+
+	const uint8_t drawn = console.render();
+	if (drawn != expectedCells && failures++ < 10)
+		printf("FAIL %s: render drew %u cells, %u were dirty\n", phase, drawn, expectedCells);
+	memset(shadow.dirty, 0, sizeof(shadow.dirty));
+	checkCells(console, shadow, phase);
+
+	uint8_t before[8][128];
+	memcpy(before, HostSdk::gddram.ram, sizeof(before));
+	for (int page = 0; page < 8; page++)
+		for (int x = 0; x < 128; x++)
+			if (!sent[page][x]) HostSdk::gddram.ram[page][x] ^= 0xA5;
+	const size_t bytes = HostSdk::i2cBytes;
+	console.flush();
+	if (HostSdk::i2cBytes - bytes != expectedBytes && failures++ < 10)
+		printf("FAIL %s: flush sent %zu I2C bytes, the dirty runs take %zu\n", phase, HostSdk::i2cBytes - bytes, expectedBytes);
+	for (int page = 0; page < 8; page++)
+		for (int x = 0; x < 128; x++)
+		{
+			const uint8_t expected = sent[page][x] ? consoleBuffer[(page * 128) + x] : (before[page][x] ^ 0xA5);
+			if (HostSdk::gddram.ram[page][x] != expected && failures++ < 10)
+				printf("FAIL %s: display RAM page %d column %d is %02X, expected %02X%s\n", phase, page, x,
+					HostSdk::gddram.ram[page][x], expected, sent[page][x] ? "" : ", it was not dirty");
+			if (!sent[page][x]) HostSdk::gddram.ram[page][x] ^= 0xA5;
+		}
+
+	const size_t again = HostSdk::i2cBytes;
+	console.flush();
+	if (HostSdk::i2cBytes != again && failures++ < 10)
+		printf("FAIL %s: a second flush sent %zu I2C bytes\n", phase, HostSdk::i2cBytes - again);
+}
+
+/*! @brief The incremental buffer must equal every cell rendered from scratch */
+static void checkFullRender(const Shadow& shadow, const char* phase)
+{
+	SSD1306 reference(128, 64);
+	reference.OLEDSetBufferPtr(128, 64, referenceBuffer);
+	reference.OLEDclearBuffer();
+	SSD1306_Console full(reference);
+	for (uint8_t row = 0; row < SSD1306_Console::Rows; row++)
+		for (uint8_t column = 0; column < SSD1306_Console::Columns; column++)
+			full.setCell(column, row, shadow.value[row][column], shadow.attr[row][column]);
+	full.invalidate();
+	full.render();
+	if (memcmp(consoleBuffer, referenceBuffer, sizeof(consoleBuffer)) != 0 && failures++ < 10)
+		printf("FAIL %s: rendered cells differ from a full render\n", phase);
+}
+
+int main()
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, consoleBuffer);
+	oled.OLEDclearBuffer();
+	SSD1306_Console console(oled);
+	Shadow shadow;
+
+	// a new console is blank and clean, blanking it again changes nothing
+	checkCells(console, shadow, "new");
+	console.clear();
+	checkCells(console, shadow, "clear blank");
+	renderAndFlush(console, shadow, "nothing dirty");
+
+	// everything once, the display RAM then holds the whole buffer
+	console.invalidate();
+	for (uint8_t row = 0; row < SSD1306_Console::Rows; row++)
+		for (uint8_t column = 0; column < SSD1306_Console::Columns; column++)
+			shadow.dirty[row][column] = true;
+	checkCells(console, shadow, "invalidate");
+	renderAndFlush(console, shadow, "invalidate");
+
+	// same content is not a change, cells off the grid are ignored
+	console.setCell(3, 2, 'A');
+	shadow.set(3, 2, 'A', 0);
+	console.setCell(3, 2, 'A');
+	console.setCell(SSD1306_Console::Columns, 2, 'B');
+	console.setCell(0, SSD1306_Console::Rows, 'B');
+	console.setCell(4, 2, ' ');
+	console.setCell(5, 2, ' ', SSD1306_Console::AttrInvert);
+	shadow.set(5, 2, ' ', SSD1306_Console::AttrInvert);
+	checkCells(console, shadow, "setCell");
+	if (console.getChar(SSD1306_Console::Columns, 0) != ' ' || console.isDirty(0, SSD1306_Console::Rows))
+	{
+		printf("FAIL getChar or isDirty outside the grid\n");
+		failures++;
+	}
+	renderAndFlush(console, shadow, "setCell");
+	checkFullRender(shadow, "setCell");
+
+	// printAt stops at the row end and returns the column after the text
+	const uint8_t end = console.printAt(17, 4, "RPM 1234");
+	for (uint8_t column = 17; column < SSD1306_Console::Columns; column++) shadow.set(column, 4, "RPM 1234"[column - 17], 0);
+	if (end != SSD1306_Console::Columns && failures++ < 10) printf("FAIL printAt returned column %u\n", end);
+	checkCells(console, shadow, "printAt");
+	renderAndFlush(console, shadow, "printAt");
+
+	// a shorter line blanks the old tail, the shared prefix stays clean
+	console.printLine(6, "SFM 12.5 m/min");
+	shadow.line(6, "SFM 12.5 m/min", 0);
+	renderAndFlush(console, shadow, "printLine");
+	console.printLine(6, "SFM 9");
+	shadow.line(6, "SFM 9", 0);
+	checkCells(console, shadow, "printLine shorter");
+	if ((console.isDirty(0, 6) || !console.isDirty(4, 6) || !console.isDirty(13, 6) || console.isDirty(14, 6))
+		&& failures++ < 10)
+		printf("FAIL printLine shorter: prefix, changed cells or blank tail marked wrong\n");
+	renderAndFlush(console, shadow, "printLine shorter");
+	console.printLine(6, "SFM 9", SSD1306_Console::AttrInvert);
+	shadow.line(6, "SFM 9", SSD1306_Console::AttrInvert);
+	checkCells(console, shadow, "printLine inverted");
+	renderAndFlush(console, shadow, "printLine inverted");
+	checkFullRender(shadow, "printLine");
+
+	// random edits, several runs per row
+	Random rnd{7};
+	for (int round = 0; round < 500; round++)
+	{
+		for (int k = rnd.next(12); k > 0; k--)
+		{
+			const uint8_t column = rnd.next(SSD1306_Console::Columns + 2);
+			const uint8_t row = rnd.next(SSD1306_Console::Rows + 1);
+			const char value = static_cast<char>(rnd.next(4) == 0 ? ' ' : rnd.next(95, 32));
+			const uint8_t attr = (rnd.next(6) == 0) ? SSD1306_Console::AttrInvert : SSD1306_Console::AttrNone;
+			console.setCell(column, row, value, attr);
+			shadow.set(column, row, value, attr);
+		}
+		if (rnd.next(20) == 0)
+		{
+			const uint8_t row = rnd.next(SSD1306_Console::Rows);
+			console.printLine(row, "0.0", SSD1306_Console::AttrNone);
+			shadow.line(row, "0.0", SSD1306_Console::AttrNone);
+		}
+		checkCells(console, shadow, "random edits");
+		renderAndFlush(console, shadow, "random edits");
+	}
+	checkFullRender(shadow, "random edits");
+
+	if (failures == 0) printf("Console cells, render and dirty run flush correct\n");
+	return failures == 0 ? 0 : 1;
+}
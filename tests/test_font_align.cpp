@@ -0,0 +1,224 @@
+/*!
+	@file test_font_align.cpp
+	@brief Host test, page aligned fonts draw the same pixels as the raw fonts.
+	@details The reference draws a raw glyph one drawPixel per font pixel,
+		scaled, decoding both raw layouts as writeChar did before every font
+		went through the column byte blitter. Every glyph of every bundled
+		font, and of bit stream fonts whose height is not a multiple of 8, is
+		drawn at scale 1-4, at every rotation, inverted or not, with and
+		without a clip rectangle, through each way of selecting the font:
+		-# setFont of the raw table, byte height fonts only
+		-# setFont of the FontTools::pageAlignFont table
+		-# setFont(font, scratch)
+		The RLE and proportional bundled fonts are checked against the raw
+		sixteen segment font they are made from, and the default and wide
+		fonts are converted to RLE and proportional at run time, the default
+		font declares 256 glyphs but stores 255.
+*/
+
+#include <cstring>
+#include <vector>
+#include "ssd1306/SSD1306_OLED.hpp"
+#include "ssd1306/SSD1306_OLED_font_tools.hpp"
+
+static uint8_t fontBuffer[128 * (64 / 8)];
+static uint8_t referenceBuffer[128 * (64 / 8)];
+
+/*!
+	@brief Raw bit stream font of N glyphs, '0' onwards, filled with pseudo random pixels
+	@tparam W glyph width
+	@tparam H glyph height, not a multiple of 8
+*/
+template <size_t W, size_t H, size_t N>
+constexpr std::array<uint8_t, 4 + (N * ((W * H) / 8))> bitStreamFont(uint32_t seed)
+{
+	std::array<uint8_t, 4 + (N * ((W * H) / 8))> font{};
+	font[0] = W;
+	font[1] = H;
+	font[2] = '0';
+	font[3] = N - 1;
+	for (size_t i = 4; i < font.size(); i++)
+	{
+		seed = (seed * 1664525u) + 1013904223u;
+		font[i] = static_cast<uint8_t>(seed >> 24);
+	}
+	return font;
+}
+
+static constexpr auto Font5x7 = bitStreamFont<5, 7, 10>(1);
+static constexpr auto Font3x6 = bitStreamFont<3, 6, 10>(2);
+static constexpr auto Font11x13 = bitStreamFont<11, 13, 10>(3);
+static constexpr auto Font4x10 = bitStreamFont<4, 10, 10>(4);
+static constexpr auto Font5x7Aligned = FontTools::pageAlignFont<FontTools::pageAlignedFontSize(Font5x7)>(Font5x7);
+static constexpr auto Font3x6Aligned = FontTools::pageAlignFont<FontTools::pageAlignedFontSize(Font3x6)>(Font3x6);
+static constexpr auto Font11x13Aligned = FontTools::pageAlignFont<FontTools::pageAlignedFontSize(Font11x13)>(Font11x13);
+static constexpr auto Font4x10Aligned = FontTools::pageAlignFont<FontTools::pageAlignedFontSize(Font4x10)>(Font4x10);
+
+/*! @brief Pixel of a raw glyph, both raw layouts, as writeChar decoded them */
+static bool rawPixel(std::span<const uint8_t> raw, size_t glyph, size_t col, size_t row)
+{
+	const size_t width = raw[0];
+	const size_t height = raw[1];
+	if (height % 8 == 0)
+	{
+		const size_t index = 4 + (glyph * width * (height / 8)) + ((row / 8) * width) + col;
+		return raw[index] & (1 << (row % 8));
+	}
+	const size_t pos = (col * height) + row;
+	const size_t index = 4 + (glyph * ((width * height) / 8)) + (pos / 8);
+	return raw[index] & (0x80 >> (pos % 8));
+}
+
+/*!
+	@brief Draw raw glyph columns one scaled pixel at a time
+	@param first first raw column drawn, the glyph is drawn from x
+	@param width columns drawn
+	@param advance columns filled, background past width
+*/
+static void referenceGlyph(SSD1306& oled, std::span<const uint8_t> raw, size_t glyph, int16_t x, int16_t y,
+	uint8_t scale, bool invert, size_t first, size_t width, size_t advance)
+{
+	for (size_t col = 0; col < advance; col++)
+		for (size_t row = 0; row < raw[1]; row++)
+		{
+			const bool ink = (col < width) && rawPixel(raw, glyph, first + col, row);
+			for (uint8_t dy = 0; dy < scale; dy++)
+				for (uint8_t dx = 0; dx < scale; dx++)
+					oled.drawPixel(x + (col * scale) + dx, y + (row * scale) + dy, ink != invert);
+		}
+}
+
+static SSD1306 oled(128, 64);
+static SSD1306 reference(128, 64);
+static int failures = 0;
+static long glyphsDrawn = 0;
+
+/*! @brief One font under test, drawn through each font it can be selected as */
+struct FontCase {
+	const char* name;
+	std::span<const uint8_t> raw;                /**< raw font the reference decodes */
+	std::vector<std::span<const uint8_t>> fonts; /**< tables passed to setFont(font) */
+	std::span<const uint8_t> scratchFont;        /**< table passed to setFont(font, scratch) */
+	bool proportional;                           /**< reference trims to the glyph ink */
+};
+
+static void drawEveryWay(const FontCase& test, std::span<uint8_t> scratch, int16_t x, int16_t y, uint8_t scale, bool invert)
+{
+	// writeChar takes a char, codes past 127 cannot be asked for
+	const size_t glyphs = std::min<size_t>(FontTools::rawGlyphCount(test.raw), 128 - test.raw[2]);
+	for (size_t g = 0; g < glyphs; g++)
+	{
+		const char value = static_cast<char>(test.raw[2] + g);
+		size_t first = 0;
+		size_t width = test.raw[0];
+		size_t advance = test.raw[0];
+		if (test.proportional)
+		{
+			uint8_t w = 0, a = 0;
+			FontTools::convertGlyph(test.raw, g, SSD1306_OLEDFonts::FontFormatProportional, 4, nullptr, w, a);
+			size_t last = 0;
+			FontTools::glyphInkColumns(test.raw, g, first, last);
+			width = w;
+			advance = a;
+		}
+		memset(referenceBuffer, 0, sizeof(referenceBuffer));
+		referenceGlyph(reference, test.raw, g, x, y, scale, invert, first, width, advance);
+
+		for (size_t f = 0; f <= test.fonts.size(); f++)
+		{
+			const bool viaScratch = (f == test.fonts.size());
+			const DisplayRet::Ret_Codes_e selected = viaScratch ?
+				oled.setFont(test.scratchFont, scratch) : oled.setFont(test.fonts[f]);
+			if (selected != DisplayRet::Success)
+			{
+				if (failures++ < 10) printf("FAIL %s font %zu not selected, error %d\n", test.name, f, selected);
+				continue;
+			}
+			oled.setInvertFont(invert);
+			oled.setTextScale(scale);
+			memset(fontBuffer, 0, sizeof(fontBuffer));
+			const DisplayRet::Ret_Codes_e drawn = oled.writeChar(x, y, value);
+			glyphsDrawn++;
+			if ((drawn != DisplayRet::Success || memcmp(fontBuffer, referenceBuffer, sizeof(fontBuffer)) != 0)
+				&& failures++ < 10)
+			{
+				printf("FAIL %s %s glyph %zu at (%d,%d) scale %u rotation %u%s%s\n", test.name,
+					viaScratch ? "setFont(font, scratch)" : "setFont(font)", g, x, y, scale,
+					oled.getRotation(), invert ? " inverted" : "", oled.getTextScale() != scale ? " scale clamped" : "");
+			}
+		}
+	}
+}
+
+static std::vector<uint8_t> pageAlignedCopy(std::span<const uint8_t> raw)
+{
+	std::vector<uint8_t> font(FontTools::pageAlignedFontSize(raw));
+	FontTools::writeFont(raw, SSD1306_OLEDFonts::FontFormatRaw, 0, font.data());
+	return font;
+}
+
+/*! @brief Raw font converted by FontTools::writeFont, spacing 4 as the proportional reference */
+static std::vector<uint8_t> convertedCopy(std::span<const uint8_t> raw, uint8_t flags)
+{
+	std::vector<uint8_t> font(FontTools::convertedFontSize(raw, flags, 4));
+	FontTools::writeFont(raw, flags, 4, font.data());
+	return font;
+}
+
+int main()
+{
+	oled.OLEDSetBufferPtr(128, 64, fontBuffer);
+	reference.OLEDSetBufferPtr(128, 64, referenceBuffer);
+	std::vector<uint8_t> scratch(4096);
+
+	const std::vector<uint8_t> defaultAligned = pageAlignedCopy(pFontDefault);
+	const std::vector<uint8_t> wideAligned = pageAlignedCopy(pFontWide);
+	const std::vector<uint8_t> sixteenSegAligned = pageAlignedCopy(pFontSixteenSeg);
+	const std::vector<uint8_t> defaultRLE = convertedCopy(pFontDefault, SSD1306_OLEDFonts::FontFormatRLE);
+	const std::vector<uint8_t> defaultProp = convertedCopy(pFontDefault, SSD1306_OLEDFonts::FontFormatProportional);
+	const std::vector<uint8_t> wideRLE = convertedCopy(pFontWide, SSD1306_OLEDFonts::FontFormatRLE);
+	const std::vector<uint8_t> wideProp = convertedCopy(pFontWide, SSD1306_OLEDFonts::FontFormatProportional);
+	const FontCase cases[] = {
+		{"pFontDefault", pFontDefault, {pFontDefault, defaultAligned}, pFontDefault, false},
+		{"pFontDefault RLE", pFontDefault, {defaultRLE}, defaultRLE, false},
+		{"pFontDefault proportional", pFontDefault, {defaultProp}, defaultProp, true},
+		{"pFontWide", pFontWide, {pFontWide, wideAligned}, pFontWide, false},
+		{"pFontWide RLE", pFontWide, {wideRLE}, wideRLE, false},
+		{"pFontWide proportional", pFontWide, {wideProp}, wideProp, true},
+		{"pFontSixteenSeg", pFontSixteenSeg, {pFontSixteenSeg, sixteenSegAligned}, pFontSixteenSeg, false},
+		{"pFontSixteenSegRLE", pFontSixteenSeg, {pFontSixteenSegRLE}, pFontSixteenSegRLE, false},
+		{"pFontSixteenSegProp", pFontSixteenSeg, {pFontSixteenSegProp}, pFontSixteenSegProp, true},
+		{"5x7 bit stream", Font5x7, {Font5x7Aligned}, Font5x7, false},
+		{"3x6 bit stream", Font3x6, {Font3x6Aligned}, Font3x6, false},
+		{"11x13 bit stream", Font11x13, {Font11x13Aligned}, Font11x13, false},
+		{"4x10 bit stream", Font4x10, {Font4x10Aligned}, Font4x10, false},
+	};
+
+	for (uint8_t rotation = 0; rotation < 4; rotation++)
+	{
+		const auto rotate = static_cast<SSD1306_graphics::display_rotate_e>(rotation);
+		oled.setRotation(rotate);
+		reference.setRotation(rotate);
+		for (bool clipped : {false, true})
+		{
+			if (clipped) {
+				oled.setClipRect(2, 1, 50, 40);
+				reference.setClipRect(2, 1, 50, 40);
+			} else {
+				oled.resetClip();
+				reference.resetClip();
+			}
+			for (const FontCase& test : cases)
+				for (uint8_t scale = 1; scale <= 4; scale++)
+					for (bool invert : {false, true})
+					{
+						// on the screen, then hanging off the top left and the bottom right
+						drawEveryWay(test, scratch, 3, 5, scale, invert);
+						drawEveryWay(test, scratch, -3, -5, scale, invert);
+						drawEveryWay(test, scratch, oled.width() - 9, oled.height() - 11, scale, invert);
+					}
+		}
+	}
+	if (failures == 0) printf("Page aligned fonts match the raw fonts, %ld glyphs drawn\n", glyphsDrawn);
+	return failures == 0 ? 0 : 1;
+}
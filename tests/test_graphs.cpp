@@ -0,0 +1,133 @@
+/*!
+	@file test_graphs.cpp
+	@brief Host test, incremental sparkline and bar graph updates against redraw().
+	@details The buffer starts as random pixels, each chart is drawn once
+		with redraw(), then updated with random values. After every update
+		that reports a change the buffer is saved, the chart redrawn from its
+		state and the two compared, and the pixels outside the chart must
+		still be the starting ones:
+		-# SSD1306_Sparkline::addSample at rotation 0, page aligned, the
+			OLEDscrollRegionLeft path, one and several samples per column
+		-# the redraw fallback at rotation 90, and at rotation 0 when the
+			area is not page aligned
+		-# SSD1306_BarGraph::setValue, values past both ends included
+*/
+
+#include <algorithm>
+#include <cstring>
+#include "ssd1306/SSD1306_OLED_graphs.hpp"
+
+static uint8_t chartBuffer[128 * (64 / 8)];
+static uint8_t background[128 * (64 / 8)];
+static uint8_t updated[128 * (64 / 8)];
+static int failures = 0;
+
+/*! @brief Small deterministic generator, a failing case can be replayed */
+struct Random {
+	uint32_t state;
+	int16_t next(int16_t range, int16_t offset = 0) {
+		state = (state * 1103515245u) + 12345u;
+		return static_cast<int16_t>(((state >> 16) % range) + offset);
+	}
+};
+
+/*! @brief Random pixels everywhere, kept to check the chart stays inside its bounds */
+static void fillBackground(Random& rnd)
+{
+	for (size_t i = 0; i < sizeof(chartBuffer); i++)
+		chartBuffer[i] = background[i] = static_cast<uint8_t>(rnd.next(256));
+}
+
+/*!
+	@brief The buffer after an update must equal a redraw, and match the background outside the chart
+	@param redraw draws the chart again from its state
+*/
+template <class Redraw>
+static void checkAgainstRedraw(SSD1306& oled, const ClipRect& bounds, Redraw redraw, const char* name, int step)
+{
+	memcpy(updated, chartBuffer, sizeof(chartBuffer));
+	redraw();
+	if (memcmp(updated, chartBuffer, sizeof(chartBuffer)) != 0 && failures++ < 10)
+		printf("FAIL %s step %d: incremental update differs from redraw()\n", name, step);
+
+	// every pixel outside the chart keeps the background, the chart area mapped through the rotation
+	uint8_t inside[128 * (64 / 8)] = {};
+	SSD1306 mask(128, 64);
+	mask.OLEDSetBufferPtr(128, 64, inside);
+	mask.setRotation(static_cast<SSD1306_graphics::display_rotate_e>(oled.getRotation()));
+	mask.fillRect(bounds.x0, bounds.y0, bounds.x1 - bounds.x0, bounds.y1 - bounds.y0, SSD1306::WHITE);
+	for (size_t i = 0; i < sizeof(inside); i++)
+		if (((updated[i] ^ background[i]) & ~inside[i]) && failures++ < 10)
+		{
+			printf("FAIL %s step %d: page %zu column %zu changed outside the chart\n", name, step, i / 128, i % 128);
+			break;
+		}
+}
+
+static void checkSparkline(uint8_t rotation, int16_t x, int16_t y, int16_t w, int16_t h, uint8_t samplesPerColumn,
+	bool expectScroll, const char* name)
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, chartBuffer);
+	oled.setRotation(static_cast<SSD1306_graphics::display_rotate_e>(rotation));
+	Random rnd{static_cast<uint32_t>(rotation * 100 + samplesPerColumn)};
+	fillBackground(rnd);
+
+	const bool scrolls = oled.OLEDscrollRegionLeft(x, y, w, h, 0) == DisplayRet::Success;
+	if (scrolls != expectScroll && failures++ < 10)
+		printf("FAIL %s: OLEDscrollRegionLeft %s\n", name, scrolls ? "accepts the area" : "refuses the area");
+	memcpy(chartBuffer, background, sizeof(chartBuffer));
+
+	SSD1306_Sparkline spark(oled, x, y, w, h, -500, 3000, samplesPerColumn);
+	spark.redraw();
+	memcpy(background, chartBuffer, sizeof(chartBuffer));
+	int16_t value = 1500;
+	for (int step = 0; step < 400; step++)
+	{
+		// a random walk with the odd spike past both ends of the range
+		value = std::clamp<int16_t>(value + rnd.next(601, -300), -1000, 4000);
+		const int16_t sample = (rnd.next(40) == 0) ? rnd.next(6000, -2000) : value;
+		memcpy(updated, chartBuffer, sizeof(chartBuffer));
+		const bool changed = spark.addSample(sample);
+		const bool columnDone = ((step + 1) % samplesPerColumn) == 0;
+		if (changed != columnDone && failures++ < 10)
+			printf("FAIL %s step %d: addSample returned %d\n", name, step, changed);
+		if (changed) checkAgainstRedraw(oled, spark.bounds(), [&] { spark.redraw(); }, name, step);
+		else if (memcmp(chartBuffer, updated, sizeof(chartBuffer)) != 0 && failures++ < 10)
+			printf("FAIL %s step %d: an unfinished column changed the buffer\n", name, step);
+	}
+}
+
+static void checkBarGraph(uint8_t rotation)
+{
+	SSD1306 oled(128, 64);
+	oled.OLEDSetBufferPtr(128, 64, chartBuffer);
+	oled.setRotation(static_cast<SSD1306_graphics::display_rotate_e>(rotation));
+	Random rnd{31u + rotation};
+	fillBackground(rnd);
+	SSD1306_BarGraph bar(oled, 3, 21, 57, 11, 0, 3000);
+	bar.redraw();
+	memcpy(background, chartBuffer, sizeof(chartBuffer));
+	for (int step = 0; step < 2000; step++)
+	{
+		const int32_t value = rnd.next(4000, -500);
+		memcpy(updated, chartBuffer, sizeof(chartBuffer));
+		if (bar.setValue(value))
+			checkAgainstRedraw(oled, bar.bounds(), [&] { bar.redraw(); }, "bar graph", step);
+		else if (memcmp(chartBuffer, updated, sizeof(chartBuffer)) != 0 && failures++ < 10)
+			printf("FAIL bar graph step %d: setValue returned false but changed the buffer\n", step);
+	}
+}
+
+int main()
+{
+	checkSparkline(0, 10, 16, 100, 24, 1, true, "sparkline rotation 0");
+	checkSparkline(0, 0, 8, 128, 8, 3, true, "sparkline rotation 0, 3 samples per column");
+	checkSparkline(0, 5, 13, 90, 20, 1, false, "sparkline rotation 0 unaligned");
+	checkSparkline(1, 4, 16, 56, 40, 1, false, "sparkline rotation 90");
+	checkSparkline(1, 0, 8, 64, 24, 2, false, "sparkline rotation 90, 2 samples per column");
+	checkBarGraph(0);
+	checkBarGraph(1);
+	if (failures == 0) printf("Sparkline scrolling and bar graph updates match redraw()\n");
+	return failures == 0 ? 0 : 1;
+}
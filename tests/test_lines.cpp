@@ -0,0 +1,96 @@
+/*!
+	@file test_lines.cpp
+	@brief Host test, drawLine against the per pixel Bresenham it replaced.
+	@details The reference is the original loop, one drawPixel per pixel, on a
+		second display with the same rotation and clip. Lines run between a
+		grid of end points on and off the screen and from the centre to every
+		point of a ring, at every rotation, with and without a clip
+		rectangle, drawn inverse so a pixel plotted twice shows up.
+*/
+
+#include <cstring>
+#include <utility>
+#include "ssd1306/SSD1306_OLED.hpp"
+
+static uint8_t lineBuffer[128 * (64 / 8)];
+static uint8_t referenceBuffer[128 * (64 / 8)];
+
+/*! @brief drawLine as it was before the run-slice version */
+static void referenceLine(SSD1306& oled, int16_t x0, int16_t y0, int16_t x1, int16_t y1, uint8_t color)
+{
+	const bool steep = abs(y1 - y0) > abs(x1 - x0);
+	if (steep) {
+		std::swap(x0, y0);
+		std::swap(x1, y1);
+	}
+	if (x0 > x1) {
+		std::swap(x0, x1);
+		std::swap(y0, y1);
+	}
+	const int16_t dx = x1 - x0;
+	const int16_t dy = abs(y1 - y0);
+	int16_t err = dx / 2;
+	const int16_t ystep = (y0 < y1) ? 1 : -1;
+	for (; x0 <= x1; x0++) {
+		if (steep) oled.drawPixel(y0, x0, color);
+		else oled.drawPixel(x0, y0, color);
+		err -= dy;
+		if (err < 0) {
+			y0 += ystep;
+			err += dx;
+		}
+	}
+}
+
+static SSD1306 oled(128, 64);
+static SSD1306 reference(128, 64);
+static int failures = 0;
+
+static void check(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+	memset(lineBuffer, 0, sizeof(lineBuffer));
+	memset(referenceBuffer, 0, sizeof(referenceBuffer));
+	oled.drawLine(x0, y0, x1, y1, SSD1306::INVERSE);
+	referenceLine(reference, x0, y0, x1, y1, SSD1306::INVERSE);
+	if (memcmp(lineBuffer, referenceBuffer, sizeof(lineBuffer)) != 0 && failures++ < 10)
+		printf("FAIL drawLine(%d,%d,%d,%d) rotation %u\n", x0, y0, x1, y1, oled.getRotation());
+}
+
+int main()
+{
+	oled.OLEDSetBufferPtr(128, 64, lineBuffer);
+	reference.OLEDSetBufferPtr(128, 64, referenceBuffer);
+	long lines = 0;
+	for (uint8_t rotation = 0; rotation < 4; rotation++)
+	{
+		for (bool clipped : {false, true})
+		{
+			const auto rotate = static_cast<SSD1306_graphics::display_rotate_e>(rotation);
+			oled.setRotation(rotate);
+			reference.setRotation(rotate);
+			if (clipped) {
+				oled.setClipRect(3, 2, 40, 30);
+				reference.setClipRect(3, 2, 40, 30);
+			} else {
+				oled.resetClip();
+				reference.resetClip();
+			}
+
+			for (int16_t x0 = -20; x0 < 150; x0 += 11)
+				for (int16_t y0 = -20; y0 < 150; y0 += 9)
+					for (int16_t x1 = -25; x1 < 155; x1 += 13)
+						for (int16_t y1 = -25; y1 < 155; y1 += 10, lines++)
+							check(x0, y0, x1, y1);
+			// every slope from the centre, ring of radius 40
+			for (int16_t d = -40; d <= 40; d++, lines += 4)
+			{
+				check(32, 32, 32 + d, -8);
+				check(32, 32, 32 + d, 72);
+				check(32, 32, -8, 32 + d);
+				check(32, 32, 72, 32 + d);
+			}
+		}
+	}
+	if (failures == 0) printf("drawLine matches the per pixel Bresenham, %ld lines\n", lines);
+	return failures == 0 ? 0 : 1;
+}
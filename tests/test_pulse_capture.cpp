@@ -0,0 +1,164 @@
+/*!
+	@file test_pulse_capture.cpp
+	@brief Host test, PulseCapture interval maths and ring reading.
+	@details The PIO state machine is replaced by a stream of X counter
+		values, each counting down from the last by the cycles to the next
+		edge, pushed through the DMA stand-in into the capture ring:
+		-# intervals across the wrap of the X counter, read in small batches
+		-# a ring of exactly RingSize - 1 unread edges, then a lapped ring,
+			which skips to the newest half and counts the rest in lost()
+		-# discard()
+		-# a DMA run ending and being restarted by the reader
+		-# sample(), the edge count of the frequency mode gate
+*/
+
+#include <cstdio>
+#include <deque>
+#include "tach/pulse_capture.hpp"
+#include "host_sdk.hpp"
+
+// X counts down by one every 2 cycles, each edge costs 3 cycles more
+static_assert(PulseCapture::intervalCycles(1000, 900) == 203);
+static_assert(PulseCapture::intervalCycles(7, 7) == 3);
+static_assert(PulseCapture::intervalCycles(5, 0xFFFFFFFBu) == 23, "X wrapped between the edges");
+static_assert(PulseCapture::intervalCycles(0x7FFFFFFEu, 0) == UINT32_MAX, "longest interval that fits");
+static_assert(PulseCapture::intervalCycles(0x7FFFFFFFu, 0) == UINT32_MAX, "saturates past 32 bits");
+
+static int failures = 0;
+
+/*! @brief The state machine side, X counter values pushed on each edge */
+struct EdgeSource {
+	uint32_t x = 40;                /**< X register, starts near the wrap */
+	uint32_t seed = 12345;          /**< for random gaps */
+	std::deque<uint32_t> expected;  /**< intervals not read yet, oldest first */
+
+	/*! @brief One edge, cycles / 2 counts after the previous one */
+	void edge(uint32_t counts)
+	{
+		x -= counts;
+		if (!HostSdk::dma.push(x)) return;
+		const uint64_t cycles = (2ull * counts) + 3;
+		expected.push_back(cycles > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(cycles));
+	}
+
+	void edges(size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			seed = (seed * 1103515245u) + 12345u;
+			edge((seed >> 8) % 50000);
+		}
+	}
+};
+
+/*! @brief Read everything, in batches of at most batch, and compare with the oldest expected intervals */
+static void readAndCheck(PulseCapture& capture, EdgeSource& source, size_t batch, const char* phase)
+{
+	uint32_t intervals[64];
+	size_t read = 0;
+	size_t count;
+	while ((count = capture.readIntervals(intervals, batch)) > 0)
+	{
+		for (size_t i = 0; i < count; i++, read++)
+		{
+			if (source.expected.empty())
+			{
+				if (failures++ < 10) printf("FAIL %s: interval %zu was never captured\n", phase, read);
+				return;
+			}
+			if (intervals[i] != source.expected.front() && failures++ < 10)
+				printf("FAIL %s: interval %zu is %u cycles, expected %u\n", phase, read, intervals[i], source.expected.front());
+			source.expected.pop_front();
+		}
+	}
+	if (!source.expected.empty() && failures++ < 10)
+		printf("FAIL %s: %zu intervals not returned\n", phase, source.expected.size());
+	source.expected.clear();
+}
+
+static void checkSample(PulseCapture& capture, uint32_t edges, uint32_t elapsedUs, const char* phase)
+{
+	uint32_t elapsed = 0;
+	const uint32_t counted = capture.sample(elapsed);
+	if ((counted != edges || elapsed != elapsedUs) && failures++ < 10)
+		printf("FAIL %s: sample() counted %u edges in %u us, expected %u in %u us\n", phase, counted, elapsed, edges, elapsedUs);
+}
+
+static void checkLost(const PulseCapture& capture, uint32_t expected, const char* phase)
+{
+	if (capture.lost() != expected && failures++ < 10)
+		printf("FAIL %s: lost() is %u, expected %u\n", phase, capture.lost(), expected);
+}
+
+int main()
+{
+	static PulseCapture capture;
+	if (!capture.begin(pio0, 12))
+	{
+		printf("FAIL begin\n");
+		return 1;
+	}
+	if (capture.tickHz() != 125000000) failures++;
+	EdgeSource source;
+	const uint32_t half = PulseCapture::RingSize / 2;
+
+	// the first edge only starts the first interval
+	source.edge(0);
+	source.expected.clear();
+	source.edges(200);
+	source.edge(0x7FFFFFFFu);
+	source.edge(0x80000000u);
+	readAndCheck(capture, source, 7, "X wrap");
+	checkLost(capture, 0, "X wrap");
+
+	source.edges(PulseCapture::RingSize - 1);
+	readAndCheck(capture, source, 64, "full ring");
+	checkLost(capture, 0, "full ring");
+
+	// lapped: the newest half is kept, the interval across the gap is not returned
+	const size_t lapped = PulseCapture::RingSize + 100;
+	source.edges(lapped);
+	source.expected.erase(source.expected.begin(), source.expected.end() - (half - 1));
+	readAndCheck(capture, source, 64, "lapped ring");
+	checkLost(capture, lapped - half, "lapped ring");
+
+	source.edges(30);
+	capture.discard();
+	source.expected.clear();
+	source.edge(100);
+	source.expected.clear();
+	source.edges(5);
+	readAndCheck(capture, source, 64, "discard");
+
+	// the DMA run ends 10 edges from now, the reader restarts it and no edge is lost
+	HostSdk::dma.skip(HostSdk::dma.hw.transfer_count - 10);
+	capture.discard();
+	source.edge(100);
+	source.expected.clear();
+	source.edges(9);
+	if (HostSdk::dma.busy && failures++ < 10) printf("FAIL run end: DMA still busy\n");
+	readAndCheck(capture, source, 64, "run end");
+	if (!HostSdk::dma.busy && failures++ < 10) printf("FAIL run end: DMA not restarted\n");
+	source.edges(50);
+	readAndCheck(capture, source, 64, "restarted run");
+	checkLost(capture, lapped - half, "restarted run");
+
+	// every edge DMA wrote is counted, whether the ring was read, lapped or discarded
+	uint32_t elapsed = 0;
+	capture.sample(elapsed);
+	HostSdk::timeUs += 200000;
+	source.edges(3 * PulseCapture::RingSize);
+	checkSample(capture, 3 * PulseCapture::RingSize, 200000, "sample lapped ring");
+	capture.discard();
+	source.expected.clear();
+	HostSdk::dma.skip(HostSdk::dma.hw.transfer_count - 5);
+	capture.sample(elapsed);
+	source.edges(5);
+	HostSdk::timeUs += 1000;
+	checkSample(capture, 5, 1000, "sample run end");
+	source.edges(7);
+	checkSample(capture, 7, 0, "sample restarted run");
+
+	if (failures == 0) printf("PulseCapture intervals, ring reading and edge count correct\n");
+	return failures == 0 ? 0 : 1;
+}
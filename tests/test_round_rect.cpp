@@ -0,0 +1,100 @@
+/*!
+	@file test_round_rect.cpp
+	@brief Host test, fillRoundRect against the overdrawing fill it replaced.
+	@details Every radius 0-12 with widths and heights from 2r up. The fill
+		must set exactly the pixels of the earlier fill, which drew two
+		spans per step of each corner and overlapped freely, and cover the
+		outline drawRoundRect draws. The fill is also drawn inverse on a
+		clear buffer, a pixel written twice would come out clear and the
+		result differ from the white fill.
+*/
+
+#include <cstring>
+#include "ssd1306/SSD1306_OLED.hpp"
+
+static uint8_t outline[128 * (64 / 8)];
+static uint8_t fill[128 * (64 / 8)];
+static uint8_t inverse[128 * (64 / 8)];
+static uint8_t baseline[128 * (64 / 8)];
+
+/*! @brief The fill before one span per column, white only, overdraw is harmless there */
+static void baselineFillRoundRect(SSD1306& oled, int16_t x, int16_t y, int16_t w, int16_t h, int16_t r)
+{
+	oled.fillRect(x + r, y, w - 2 * r, h, SSD1306::WHITE);
+	const int16_t delta = h - 2 * r - 1;
+	const int16_t centres[2] = {static_cast<int16_t>(x + w - r - 1), static_cast<int16_t>(x + r)};
+	for (int half = 0; half < 2; half++)
+	{
+		const int16_t x0 = centres[half];
+		const int16_t y0 = y + r;
+		const int16_t side = (half == 0) ? 1 : -1;
+		int16_t f = 1 - r;
+		int16_t ddF_x = 1;
+		int16_t ddF_y = -2 * r;
+		int16_t cx = 0;
+		int16_t cy = r;
+		while (cx < cy)
+		{
+			if (f >= 0)
+			{
+				cy--;
+				ddF_y += 2;
+				f += ddF_y;
+			}
+			cx++;
+			ddF_x += 2;
+			f += ddF_x;
+			oled.drawFastVLine(x0 + (side * cx), y0 - cy, 2 * cy + 1 + delta, SSD1306::WHITE);
+			oled.drawFastVLine(x0 + (side * cy), y0 - cx, 2 * cx + 1 + delta, SSD1306::WHITE);
+		}
+	}
+}
+
+int main()
+{
+	SSD1306 oled(128, 64);
+	int failures = 0;
+	for (int16_t r = 0; r <= 12; r++)
+	{
+		for (int16_t w = 2 * r; w <= 2 * r + 5; w++)
+		{
+			for (int16_t h = 2 * r; h <= 2 * r + 8; h++)
+			{
+				if (w < 1 || h < 1) continue;
+				oled.OLEDSetBufferPtr(128, 64, outline);
+				oled.OLEDclearBuffer();
+				oled.drawRoundRect(10, 10, w, h, r, SSD1306::WHITE);
+				oled.OLEDSetBufferPtr(128, 64, fill);
+				oled.OLEDclearBuffer();
+				oled.fillRoundRect(10, 10, w, h, r, SSD1306::WHITE);
+				oled.OLEDSetBufferPtr(128, 64, inverse);
+				oled.OLEDclearBuffer();
+				oled.fillRoundRect(10, 10, w, h, r, SSD1306::INVERSE);
+				oled.OLEDSetBufferPtr(128, 64, baseline);
+				oled.OLEDclearBuffer();
+				baselineFillRoundRect(oled, 10, 10, w, h, r);
+
+				int missing = 0;
+				for (size_t i = 0; i < sizeof(fill); i++)
+					missing += __builtin_popcount(outline[i] & ~fill[i]);
+				if (missing != 0)
+				{
+					printf("FAIL fillRoundRect(10,10,%d,%d,%d) leaves %d outline pixels unset\n", w, h, r, missing);
+					failures++;
+				}
+				if (memcmp(fill, baseline, sizeof(fill)) != 0)
+				{
+					printf("FAIL fillRoundRect(10,10,%d,%d,%d) differs from the earlier fill\n", w, h, r);
+					failures++;
+				}
+				if (memcmp(fill, inverse, sizeof(fill)) != 0)
+				{
+					printf("FAIL fillRoundRect(10,10,%d,%d,%d) inverse writes a pixel twice\n", w, h, r);
+					failures++;
+				}
+			}
+		}
+	}
+	if (failures == 0) printf("fillRoundRect matches the earlier fill and covers its outline, %d radii\n", 13);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+/*!
+	@file test_spsc_ring.cpp
+	@brief Host test, SpscRing between a producer thread and a consumer.
+	@details The producer stands in for the hall sensor interrupt and pushes
+		sequence numbers as fast as it can, the consumer stands in for the
+		main loop and pops in batches of varying size, stalling now and then
+		so the ring fills:
+		-# values come out in order with no duplicates
+		-# consecutive values within a batch, a gap only at its first value
+		-# each gap is reported and the values missing sum to overflows()
+		-# a single threaded fill, overflow and clear()
+*/
+
+#include <cstdio>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "tach/spsc_ring.hpp"
+
+static int failures = 0;
+
+/*! @brief Fill the ring, overflow it, then read past the gap and clear */
+static void checkSingleThread(void)
+{
+	static SpscRing<uint32_t, 16> ring;
+	uint32_t values[64];
+	bool gap = true;
+	uint32_t next = 0;
+	for (; next < 16; next++)
+		if (!ring.push(next) && failures++ < 10) printf("FAIL fill: push %u refused\n", next);
+	for (; next < 19; next++)
+		if (ring.push(next) && failures++ < 10) printf("FAIL overflow: push %u to a full ring taken\n", next);
+	if (ring.overflows() != 3 && failures++ < 10) printf("FAIL overflow: overflows() is %u, expected 3\n", ring.overflows());
+
+	size_t count = ring.pop(values, 10, gap);
+	if ((count != 10 || gap || values[0] != 0) && failures++ < 10)
+		printf("FAIL first pop: %zu values from %u, gap %d\n", count, values[0], gap);
+	ring.push(next++);
+	ring.push(next++);
+	// the batch stops short of the gap even with room to spare
+	count = ring.pop(values, 64, gap);
+	if ((count != 6 || gap || values[5] != 15) && failures++ < 10)
+		printf("FAIL before gap: %zu values to %u, gap %d\n", count, values[count - 1], gap);
+	count = ring.pop(values, 64, gap);
+	if ((count != 2 || !gap || values[0] != 19) && failures++ < 10)
+		printf("FAIL after gap: %zu values from %u, gap %d\n", count, values[0], gap);
+	count = ring.pop(values, 64, gap);
+	if ((count != 0 || gap) && failures++ < 10) printf("FAIL empty: %zu values, gap %d\n", count, gap);
+
+	for (int i = 0; i < 5; i++) ring.push(next++);
+	ring.clear();
+	if (ring.pop(values, 64, gap) != 0 && failures++ < 10) printf("FAIL clear: values left\n");
+}
+
+/*! @brief Producer thread against a stalling consumer, every value accounted for */
+static void checkThreads(void)
+{
+	constexpr uint32_t Values = 4000000;
+	static SpscRing<uint32_t, 64> ring;
+	uint32_t refused = 0;
+	std::atomic<bool> finished = false;
+
+	std::thread producer([&refused, &finished] {
+		for (uint32_t i = 0; i < Values; i++)
+		{
+			if (!ring.push(i)) refused++;
+			if ((i % 16) == 0) std::this_thread::yield();
+		}
+		finished = true;
+	});
+
+	uint32_t values[100];
+	uint32_t seed = 12345;
+	int64_t last = -1;  // last value taken, -1 before the first
+	uint64_t received = 0;
+	uint64_t missing = 0;
+	uint32_t gaps = 0;
+	uint32_t batches = 0;
+	for (;;)
+	{
+		const bool producerDone = finished;  // read before pop, so an empty pop then means drained
+		seed = (seed * 1103515245u) + 12345u;
+		bool gap = false;
+		const size_t count = ring.pop(values, 1 + ((seed >> 8) % 100), gap);
+		if (count == 0)
+		{
+			if (producerDone) break;
+			std::this_thread::yield();
+			continue;
+		}
+		if (gap)
+		{
+			gaps++;
+			if (values[0] <= last + 1 && failures++ < 10)
+				printf("FAIL threads: gap reported before %u, directly after %lld\n", values[0], static_cast<long long>(last));
+		}
+		else if (values[0] != last + 1 && failures++ < 10)
+			printf("FAIL threads: %u follows %lld with no gap reported\n", values[0], static_cast<long long>(last));
+		if (values[0] <= last && failures++ < 10)
+			printf("FAIL threads: %u repeats or goes back from %lld\n", values[0], static_cast<long long>(last));
+		missing += values[0] - (last + 1);
+		for (size_t i = 1; i < count; i++)
+			if (values[i] != values[i - 1] + 1 && failures++ < 10)
+				printf("FAIL threads: %u follows %u inside a batch\n", values[i], values[i - 1]);
+		last = values[count - 1];
+		received += count;
+
+		// the main loop stalls on a display flush now and then
+		if ((++batches % 512) == 0) std::this_thread::sleep_for(std::chrono::microseconds(200));
+	}
+	producer.join();
+
+	// drops after the last stored value have no value to mark them
+	missing += (Values - 1) - last;
+	if (refused != ring.overflows() && failures++ < 10)
+		printf("FAIL threads: %u pushes refused, overflows() is %u\n", refused, ring.overflows());
+	if (missing != ring.overflows() && failures++ < 10)
+		printf("FAIL threads: %llu values missing, overflows() is %u\n", static_cast<unsigned long long>(missing), ring.overflows());
+	if (received + missing != Values && failures++ < 10)
+		printf("FAIL threads: %llu received and %llu missing of %u\n", static_cast<unsigned long long>(received), static_cast<unsigned long long>(missing), Values);
+	if (gaps == 0 && failures++ < 10) printf("FAIL threads: the ring never overflowed, nothing was tested\n");
+	printf("%llu values received, %u dropped in %u gaps\n", static_cast<unsigned long long>(received), ring.overflows(), gaps);
+}
+
+int main()
+{
+	checkSingleThread();
+	checkThreads();
+	if (failures == 0) printf("SpscRing order, gaps and overflow count correct\n");
+	return failures == 0 ? 0 : 1;
+}
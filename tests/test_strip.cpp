@@ -0,0 +1,137 @@
+/*!
+	@file test_strip.cpp
+	@brief Host test, OLEDupdateStrips against drawing into a full buffer.
+	@details Random scenes of every primitive, text and bitmaps, with clip
+		rectangles and at every rotation, are drawn once into a full screen
+		buffer and once a page at a time into a one page strip. The strips
+		reach the emulated display RAM of host_sdk.hpp over the I2C stand-in,
+		which must then hold the full buffer. A display list drawn both ways
+		is compared the same way, and OLEDupdate itself is checked first.
+*/
+
+#include <cstring>
+#include "ssd1306/SSD1306_OLED.hpp"
+#include "ssd1306/SSD1306_OLED_widgets.hpp"
+#include "host_sdk.hpp"
+
+static uint8_t fullBuffer[128 * (64 / 8)];
+static uint8_t stripBuffer[128];
+
+static const uint8_t icon[16 * 16 / 8] = {
+	0xFF, 0x81, 0x81, 0xFF, 0x3C, 0x42, 0x99, 0xA5, 0xA5, 0x99, 0x42, 0x3C, 0x00, 0xFF, 0x0F, 0xF0,
+	0xAA, 0x55, 0xAA, 0x55, 0x12, 0x34, 0x56, 0x78, 0x9A, 0xBC, 0xDE, 0xF0, 0x01, 0x02, 0x04, 0x08
+};
+
+/*! @brief Small deterministic generator, the scene must repeat exactly for each strip */
+struct Random {
+	uint32_t state;
+	int16_t next(int16_t range, int16_t offset = 0) {
+		state = (state * 1103515245u) + 12345u;
+		return static_cast<int16_t>(((state >> 16) % range) + offset);
+	}
+};
+
+static void drawScene(SSD1306& oled, uint32_t seed)
+{
+	Random rnd{seed};
+	oled.resetClip();
+	for (int k = 0; k < 12; k++)
+	{
+		const uint8_t color = rnd.next(3);
+		if (rnd.next(5) == 0) oled.setClipRect(rnd.next(140, -6), rnd.next(140, -6), rnd.next(100), rnd.next(100));
+		else if (rnd.next(4) == 0) oled.resetClip();
+		switch (rnd.next(10))
+		{
+			case 0: oled.drawLine(rnd.next(200, -40), rnd.next(200, -40), rnd.next(200, -40), rnd.next(200, -40), color); break;
+			case 1: oled.fillRect(rnd.next(140, -6), rnd.next(140, -6), rnd.next(80), rnd.next(80), color); break;
+			case 2: oled.fillCircle(rnd.next(140, -6), rnd.next(140, -6), rnd.next(30), color); break;
+			case 3: oled.drawCircle(rnd.next(140, -6), rnd.next(140, -6), rnd.next(30), color); break;
+			case 4: oled.fillTriangle(rnd.next(160, -16), rnd.next(160, -16), rnd.next(160, -16),
+				rnd.next(160, -16), rnd.next(160, -16), rnd.next(160, -16), color); break;
+			case 5:
+				oled.setFont(pFontDefault);
+				oled.setTextScale(rnd.next(2, 1));
+				oled.drawText(rnd.next(130, -4), rnd.next(130, -4), "Strip 42");
+				oled.setTextScale(1);
+				break;
+			case 6:
+				oled.setFont(pFontSixteenSegProp);
+				oled.drawText(rnd.next(140, -6), rnd.next(100, -20), "1.23");
+				break;
+			case 7: oled.OLEDBitmap(rnd.next(60, -6), rnd.next(60, -6), 16, 16, icon, rnd.next(2)); break;
+			case 8: oled.OLEDBitmapVertical(rnd.next(60, -6), rnd.next(60, -6), 16, 16, icon, rnd.next(2)); break;
+			case 9: oled.drawRoundRect(rnd.next(140, -6), rnd.next(140, -6), rnd.next(40, 20), rnd.next(30, 20), 5, color); break;
+		}
+	}
+	oled.resetClip();
+}
+
+static bool ramHolds(const uint8_t* buffer)
+{
+	return memcmp(HostSdk::gddram.ram, buffer, sizeof(HostSdk::gddram.ram)) == 0;
+}
+
+static void buildList(SSD1306_DisplayList& list)
+{
+	uint8_t id;
+	list.addDigits(id, 0, 0, 128, 48, pFontSixteenSegProp, SSD1306_graphics::alignRight);
+	list.setText(id, "1234");
+	list.addText(id, 0, 56, 128, 8, pFontDefault);
+	list.setText(id, "SFM:123");
+	list.setInvert(id, true);
+}
+
+int main()
+{
+	int failures = 0;
+	{
+		SSD1306 oled(128, 64);
+		oled.OLEDSetBufferPtr(128, 64, fullBuffer);
+		oled.OLEDclearBuffer();
+		drawScene(oled, 1);
+		memset(HostSdk::gddram.ram, 0xEE, sizeof(HostSdk::gddram.ram));
+		oled.OLEDupdate();
+		if (!ramHolds(fullBuffer))
+		{
+			printf("FAIL OLEDupdate does not copy the buffer to display RAM\n");
+			return 1;
+		}
+	}
+
+	const uint32_t scenes = 4000;
+	for (uint32_t seed = 0; seed < scenes; seed++)
+	{
+		const auto rotation = static_cast<SSD1306_graphics::display_rotate_e>(seed % 4);
+		SSD1306 full(128, 64);
+		full.OLEDSetBufferPtr(128, 64, fullBuffer);
+		full.setRotation(rotation);
+		full.OLEDclearBuffer();
+		drawScene(full, seed);
+
+		SSD1306 strips(128, 64); // no full buffer at all
+		strips.setRotation(rotation);
+		memset(HostSdk::gddram.ram, 0xEE, sizeof(HostSdk::gddram.ram));
+		strips.OLEDupdateStrips(stripBuffer, [&] { drawScene(strips, seed); });
+		if (!ramHolds(fullBuffer) && failures++ < 10)
+			printf("FAIL scene %u rotation %u differs drawn in strips\n", seed, rotation);
+	}
+
+	SSD1306 full(128, 64);
+	full.OLEDSetBufferPtr(128, 64, fullBuffer);
+	full.OLEDclearBuffer();
+	SSD1306_DisplayList fullList(full);
+	buildList(fullList);
+	fullList.render();
+	SSD1306 strips(128, 64);
+	SSD1306_DisplayList stripList(strips);
+	buildList(stripList);
+	strips.OLEDupdateStrips(stripBuffer, [&] { stripList.drawAll(); });
+	if (!ramHolds(fullBuffer))
+	{
+		printf("FAIL display list differs drawn in strips\n");
+		failures++;
+	}
+
+	if (failures == 0) printf("Strips match the full buffer, %u scenes and a display list\n", scenes);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,493 @@
+/*!
+	@file bdf2font.cpp
+	@brief Host tool, converts a BDF bitmap font to a SSD1306 font table header.
+	@details Each glyph is placed in a fixed cell on the font baseline and
+		stored as page aligned column bytes, the layout setFont expects. The
+		table is written by FontTools::writeFont, the same converter the
+		firmware runs at compile time, so it can also be made proportional,
+		run length encoded or cut to a character subset. A report of the flash
+		size and the drawing cost of every format helps to pick one.
+	@code
+		bdf2font [options] font.bdf
+			-o file     header written, default standard output
+			-n name     array name, default the file name
+			-r first-last  character codes kept, default 32-126
+			-c chars    keep only these characters (sparse font)
+			-p spacing  proportional, blank columns after each glyph
+			-z          run length encoded
+			-q          no report
+	@endcode
+*/
+
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "ssd1306/SSD1306_OLED_font_tools.hpp"
+
+/*! @brief One BDF glyph, rows as read from the BITMAP section */
+struct BdfGlyph_t
+{
+	int dwidth = 0;   /**< cursor advance in pixels */
+	int width = 0;    /**< bounding box width */
+	int height = 0;   /**< bounding box height */
+	int xoff = 0;     /**< bounding box left edge from the origin */
+	int yoff = 0;     /**< bounding box bottom edge from the baseline */
+	std::vector<std::vector<uint8_t>> rows; /**< bitmap rows, MSB is the left pixel */
+
+	/*! @brief true if a bounding box pixel is set */
+	bool pixel(int x, int y) const
+	{
+		const std::vector<uint8_t>& row = rows[y];
+		const size_t index = x / 8;
+		return index < row.size() && (row[index] & (0x80 >> (x % 8)));
+	}
+};
+
+/*! @brief The parts of a BDF font the converter needs */
+struct BdfFont_t
+{
+	int ascent = 0;  /**< rows above the baseline */
+	int descent = 0; /**< rows below the baseline */
+	std::map<int, BdfGlyph_t> glyphs; /**< glyphs by character code */
+};
+
+/*! @brief Options from the command line */
+struct Options_t
+{
+	std::string input;      /**< BDF file */
+	std::string output;     /**< header file, empty for standard output */
+	std::string name;       /**< array name */
+	int first = 32;         /**< first character code kept */
+	int last = 126;         /**< last character code kept */
+	std::string charset;    /**< characters kept by a sparse font */
+	uint8_t flags = SSD1306_OLEDFonts::FontFormatRaw; /**< format written */
+	uint8_t spacing = 1;    /**< blank columns after a proportional glyph */
+	bool report = true;     /**< print the size and cost report */
+};
+
+/*! @brief Font cell every glyph is placed in */
+struct Cell_t
+{
+	int left = 0;   /**< cell left edge from the glyph origin */
+	int top = 0;    /**< cell top row above the baseline */
+	int width = 0;  /**< cell width in pixels */
+	int height = 0; /**< cell height in pixels */
+};
+
+/*!
+	@brief Read a BDF file
+	@param path file name
+	@param font filled with the glyphs and metrics
+	@return false with a message on standard error if the file can't be read
+*/
+static bool readBdf(const std::string& path, BdfFont_t& font)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		fprintf(stderr, "bdf2font: cannot open %s\n", path.c_str());
+		return false;
+	}
+	int boxWidth = 0, boxHeight = 0, boxX = 0, boxY = 0;
+	bool haveAscent = false, haveDescent = false;
+	BdfGlyph_t glyph;
+	int encoding = -1;
+	int bitmapRows = -1; // rows of BITMAP still to read, -1 outside a bitmap
+	std::string line;
+	size_t lineNumber = 0;
+	while (std::getline(file, line))
+	{
+		lineNumber++;
+		if (!line.empty() && line.back() == '\r') line.pop_back();
+		std::istringstream words(line);
+		std::string keyword;
+		words >> keyword;
+		if (bitmapRows > 0)
+		{
+			std::vector<uint8_t> row;
+			for (size_t i = 0; i < keyword.size(); i += 2)
+				row.push_back(static_cast<uint8_t>(std::strtoul(keyword.substr(i, 2).c_str(), nullptr, 16)));
+			glyph.rows.push_back(row);
+			bitmapRows--;
+			continue;
+		}
+		if (keyword == "FONTBOUNDINGBOX")
+		{
+			words >> boxWidth >> boxHeight >> boxX >> boxY;
+		} else if (keyword == "FONT_ASCENT")
+		{
+			words >> font.ascent;
+			haveAscent = true;
+		} else if (keyword == "FONT_DESCENT")
+		{
+			words >> font.descent;
+			haveDescent = true;
+		} else if (keyword == "STARTCHAR")
+		{
+			glyph = BdfGlyph_t{};
+			glyph.width = boxWidth;
+			glyph.height = boxHeight;
+			glyph.xoff = boxX;
+			glyph.yoff = boxY;
+			glyph.dwidth = boxWidth;
+			encoding = -1;
+		} else if (keyword == "ENCODING")
+		{
+			words >> encoding;
+		} else if (keyword == "DWIDTH")
+		{
+			words >> glyph.dwidth;
+		} else if (keyword == "BBX")
+		{
+			words >> glyph.width >> glyph.height >> glyph.xoff >> glyph.yoff;
+		} else if (keyword == "BITMAP")
+		{
+			bitmapRows = glyph.height;
+		} else if (keyword == "ENDCHAR")
+		{
+			if (bitmapRows != 0)
+			{
+				fprintf(stderr, "bdf2font: %s:%zu: glyph without a complete BITMAP\n", path.c_str(), lineNumber);
+				return false;
+			}
+			if (encoding >= 0) font.glyphs[encoding] = glyph; // -1: not in the standard encoding
+			bitmapRows = -1;
+		}
+	}
+	if (!haveAscent) font.ascent = boxHeight + boxY;
+	if (!haveDescent) font.descent = -boxY;
+	if (font.glyphs.empty())
+	{
+		fprintf(stderr, "bdf2font: %s holds no glyphs\n", path.c_str());
+		return false;
+	}
+	return true;
+}
+
+/*!
+	@brief Cell that holds every kept glyph on a common baseline
+	@param font BDF font
+	@param first first character code
+	@param last last character code
+*/
+static Cell_t fontCell(const BdfFont_t& font, int first, int last)
+{
+	int left = 0, right = 0;
+	int top = font.ascent, bottom = -font.descent;
+	for (int code = first; code <= last; code++)
+	{
+		auto it = font.glyphs.find(code);
+		if (it == font.glyphs.end()) continue;
+		const BdfGlyph_t& g = it->second;
+		left = std::min(left, g.xoff);
+		right = std::max({right, g.dwidth, g.xoff + g.width});
+		top = std::max(top, g.yoff + g.height);
+		bottom = std::min(bottom, g.yoff);
+	}
+	return Cell_t{left, top, right - left, top - bottom};
+}
+
+/*!
+	@brief Build a raw font, fixed cells of page column bytes, for the converters
+	@param font BDF font
+	@param first first character code
+	@param last last character code
+	@param cell cell the glyphs are placed in
+	@return raw font table, the height rounded up to whole pages
+	@note Characters missing from the BDF file are left blank.
+*/
+static std::vector<uint8_t> rawFont(const BdfFont_t& font, int first, int last, const Cell_t& cell)
+{
+	const int pages = (cell.height + 7) / 8;
+	const size_t glyphSize = cell.width * pages;
+	std::vector<uint8_t> raw(FontTools::RawHeaderSize + (glyphSize * (last - first + 1)), 0x00);
+	raw[0] = cell.width;
+	raw[1] = pages * 8;
+	raw[2] = first;
+	raw[3] = last - first;
+	for (int code = first; code <= last; code++)
+	{
+		auto it = font.glyphs.find(code);
+		if (it == font.glyphs.end()) continue;
+		const BdfGlyph_t& g = it->second;
+		const size_t start = FontTools::RawHeaderSize + (glyphSize * (code - first));
+		for (int y = 0; y < g.height; y++)
+		{
+			const int row = cell.top - (g.yoff + g.height) + y;
+			for (int x = 0; x < g.width; x++)
+			{
+				if (!g.pixel(x, y)) continue;
+				const int col = g.xoff - cell.left + x;
+				raw[start + ((row / 8) * cell.width) + col] |= (1 << (row % 8));
+			}
+		}
+	}
+	return raw;
+}
+
+/*!
+	@brief Convert the raw font, see FontTools::writeFont
+	@param raw raw font from rawFont
+	@param height real font height, the raw height is padded to whole pages
+	@param flags SSD1306_OLEDFonts::FontFormat_e flags
+	@param spacing blank columns after a proportional glyph
+	@param charset characters kept by a sparse font
+	@return font table for setFont
+	@note Storing the real height makes writeChar clip the padding rows, the
+		page count and so the glyph data are the same.
+*/
+static std::vector<uint8_t> convert(const std::vector<uint8_t>& raw, uint8_t height, uint8_t flags,
+	uint8_t spacing, const std::string& charset)
+{
+	std::vector<uint8_t> font(FontTools::convertedFontSize(raw, flags, spacing, charset));
+	FontTools::writeFont(raw, flags, spacing, font.data(), charset);
+	font[3] = height;
+	return font;
+}
+
+/*! @brief Drawing cost of one glyph set, per glyph at text scale 1 */
+struct Cost_t
+{
+	size_t glyphs = 0;      /**< glyphs in the font */
+	size_t bytes = 0;       /**< table size */
+	size_t writesSum = 0;   /**< drawColumnByte calls, all glyphs */
+	size_t writesMax = 0;   /**< drawColumnByte calls, worst glyph */
+	size_t readsSum = 0;    /**< table bytes read, all glyphs */
+	size_t readsMax = 0;    /**< table bytes read, worst glyph */
+};
+
+/*!
+	@brief Work writeChar does per glyph of a converted font
+	@param font font table from convert
+	@return cost summary
+	@details A glyph costs one drawColumnByte per column and page up to its
+		advance, plus the table bytes read to find and decode it: the binary
+		search of a sparse font, the glyph table entry and the glyph data.
+*/
+static Cost_t fontCost(const std::vector<uint8_t>& font)
+{
+	const uint8_t flags = font[1];
+	const size_t glyphs = font[5] + 1u;
+	const size_t pages = (font[3] + 7) / 8;
+	const size_t entry = FontTools::glyphEntrySize(flags);
+	const bool sparse = flags & SSD1306_OLEDFonts::FontFormatSparse;
+	const size_t indexStart = FontTools::ExtHeaderSize + (sparse ? glyphs : 0);
+	const size_t streamStart = indexStart + (entry * glyphs);
+	size_t probes = 0;
+	if (sparse)
+		while ((1u << probes) <= glyphs) probes++;
+
+	Cost_t cost{glyphs, font.size()};
+	for (size_t g = 0; g < glyphs; g++)
+	{
+		const uint8_t* e = font.data() + indexStart + (entry * g);
+		size_t width = font[2], advance = font[2];
+		size_t start = font[2] * pages * g;
+		if (entry == 4)
+		{
+			advance = e[0];
+			width = e[1];
+		}
+		if (entry != 0) start = e[entry - 2] | (e[entry - 1] << 8);
+		size_t next = font.size() - streamStart;
+		if (g + 1 < glyphs)
+			next = (entry != 0) ? (e[2 * entry - 2] | (e[2 * entry - 1] << 8)) : start + (width * pages);
+		const size_t writes = std::max(width, advance) * pages;
+		const size_t reads = probes + entry + (next - start);
+		cost.writesSum += writes;
+		cost.writesMax = std::max(cost.writesMax, writes);
+		cost.readsSum += reads;
+		cost.readsMax = std::max(cost.readsMax, reads);
+	}
+	return cost;
+}
+
+/*!
+	@brief Print the size and drawing cost of every format of the glyph set
+	@param raw raw font from rawFont
+	@param height real font height
+	@param options command line options, the sparse flag and spacing are kept
+*/
+static void printReport(const std::vector<uint8_t>& raw, uint8_t height, const Options_t& options)
+{
+	static constexpr struct { const char* name; uint8_t flags; } Formats[] = {
+		{"fixed", SSD1306_OLEDFonts::FontFormatRaw},
+		{"fixed rle", SSD1306_OLEDFonts::FontFormatRLE},
+		{"proportional", SSD1306_OLEDFonts::FontFormatProportional},
+		{"proportional rle", SSD1306_OLEDFonts::FontFormatProportional | SSD1306_OLEDFonts::FontFormatRLE},
+	};
+	const uint8_t sparse = options.flags & SSD1306_OLEDFonts::FontFormatSparse;
+	fprintf(stderr, "%ux%u pixels, %u pages per glyph\n", raw[0], height, raw[1] / 8);
+	fprintf(stderr, "%-18s %6s %7s  %-16s %-16s\n", "format", "glyphs", "bytes", "writes avg/max", "reads avg/max");
+	for (const auto& format : Formats)
+	{
+		const uint8_t flags = format.flags | sparse;
+		const Cost_t cost = fontCost(convert(raw, height, flags, options.spacing, options.charset));
+		char writes[24], reads[24];
+		snprintf(writes, sizeof(writes), "%.1f/%zu", static_cast<double>(cost.writesSum) / cost.glyphs, cost.writesMax);
+		snprintf(reads, sizeof(reads), "%.1f/%zu", static_cast<double>(cost.readsSum) / cost.glyphs, cost.readsMax);
+		fprintf(stderr, "%-18s %6zu %7zu  %-16s %-16s%s\n", format.name, cost.glyphs, cost.bytes, writes, reads,
+			((flags & ~sparse) == (options.flags & ~sparse)) ? " <- written" : "");
+	}
+	fprintf(stderr, "writes: drawColumnByte calls per glyph, reads: font table bytes read per glyph\n");
+}
+
+/*!
+	@brief Write the font table as a C++ header
+	@param out destination
+	@param font font table
+	@param options command line options
+*/
+static void writeHeader(FILE* out, const std::vector<uint8_t>& font, const Options_t& options)
+{
+	const size_t glyphs = font[5] + 1u;
+	const size_t chars = (font[1] & SSD1306_OLEDFonts::FontFormatSparse) ? glyphs : 0;
+	const size_t entry = FontTools::glyphEntrySize(font[1]);
+	const size_t streamStart = FontTools::ExtHeaderSize + chars + (entry * glyphs);
+	fprintf(out, "/*!\n\t@file %s\n", options.output.empty() ? (options.name + ".hpp").c_str() : options.output.c_str());
+	fprintf(out, "\t@brief %ux%u font converted from %s by bdf2font, do not edit\n", font[2], font[3], options.input.c_str());
+	fprintf(out, "\t@details Format flags 0x%02X, %zu glyphs, %u pages per glyph, %zu bytes.\n",
+		font[1], glyphs, (font[3] + 7) / 8, font.size());
+	fprintf(out, "*/\n\n#pragma once\n\n#include <array>\n#include <cstdint>\n\n");
+	fprintf(out, "inline constexpr std::array<uint8_t, %zu> %s =\n{\n", font.size(), options.name.c_str());
+	fprintf(out, "0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X, 0x%02X, // marker, flags, x_size, y_size, offset, total characters\n",
+		font[0], font[1], font[2], font[3], font[4], font[5]);
+	// sparse character list, glyph table, then the glyph stream, 16 bytes per line
+	size_t pos = FontTools::ExtHeaderSize;
+	for (const size_t end : {FontTools::ExtHeaderSize + chars, streamStart, font.size()})
+	{
+		for (size_t column = 0; pos < end; pos++)
+		{
+			fprintf(out, "0x%02X%s", font[pos], (pos + 1 == font.size()) ? "" : ",");
+			if (++column == 16 || pos + 1 == end)
+			{
+				fprintf(out, "\n");
+				column = 0;
+			}
+		}
+	}
+	fprintf(out, "};\n");
+}
+
+/*! @brief Print the command line help */
+static void usage(void)
+{
+	fprintf(stderr,
+		"usage: bdf2font [options] font.bdf\n"
+		"  -o file         header written, default standard output\n"
+		"  -n name         array name, default the file name\n"
+		"  -r first-last   character codes kept, default 32-126\n"
+		"  -c chars        keep only these characters (sparse font)\n"
+		"  -p spacing      proportional, blank columns after each glyph\n"
+		"  -z              run length encoded\n"
+		"  -q              no report\n");
+}
+
+/*!
+	@brief Read the command line
+	@return false with a message on standard error if it is not valid
+*/
+static bool parseOptions(int argc, char** argv, Options_t& options)
+{
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string arg = argv[i];
+		const bool hasValue = (i + 1 < argc);
+		if (arg == "-o" && hasValue) options.output = argv[++i];
+		else if (arg == "-n" && hasValue) options.name = argv[++i];
+		else if (arg == "-r" && hasValue)
+		{
+			if (std::sscanf(argv[++i], "%i-%i", &options.first, &options.last) != 2) return false;
+		} else if (arg == "-c" && hasValue)
+		{
+			options.charset = argv[++i];
+			options.flags |= SSD1306_OLEDFonts::FontFormatSparse;
+		} else if (arg == "-p" && hasValue)
+		{
+			options.spacing = std::atoi(argv[++i]);
+			options.flags |= SSD1306_OLEDFonts::FontFormatProportional;
+		} else if (arg == "-z") options.flags |= SSD1306_OLEDFonts::FontFormatRLE;
+		else if (arg == "-q") options.report = false;
+		else if (arg[0] != '-' && options.input.empty()) options.input = arg;
+		else return false;
+	}
+	if (options.input.empty()) return false;
+	if (options.name.empty())
+	{
+		std::string base = options.input.substr(options.input.find_last_of("/\\") + 1);
+		base = base.substr(0, base.find('.'));
+		for (char& c : base)
+			if (!std::isalnum(static_cast<unsigned char>(c))) c = '_';
+		options.name = "Font" + base;
+	}
+	if (!options.charset.empty())
+	{
+		const auto [low, high] = std::minmax_element(options.charset.begin(), options.charset.end(),
+			[](char a, char b) { return static_cast<uint8_t>(a) < static_cast<uint8_t>(b); });
+		options.first = static_cast<uint8_t>(*low);
+		options.last = static_cast<uint8_t>(*high);
+	}
+	if (options.first < 0 || options.last > 255 || options.first > options.last)
+	{
+		fprintf(stderr, "bdf2font: character range must be inside 0-255\n");
+		return false;
+	}
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	Options_t options;
+	if (!parseOptions(argc, argv, options))
+	{
+		usage();
+		return 1;
+	}
+	BdfFont_t bdf;
+	if (!readBdf(options.input, bdf)) return 1;
+
+	for (int code = options.first; code <= options.last; code++)
+	{
+		const bool wanted = options.charset.empty() || options.charset.find(static_cast<char>(code)) != std::string::npos;
+		if (wanted && bdf.glyphs.find(code) == bdf.glyphs.end())
+			fprintf(stderr, "bdf2font: no glyph for character %d, left blank\n", code);
+	}
+	const Cell_t cell = fontCell(bdf, options.first, options.last);
+	if (cell.width < 1 || cell.width > 255 || cell.height < 1 || cell.height > 248)
+	{
+		fprintf(stderr, "bdf2font: %dx%d cell does not fit the font header\n", cell.width, cell.height);
+		return 1;
+	}
+	if ((options.flags & SSD1306_OLEDFonts::FontFormatRLE)
+		&& static_cast<size_t>(cell.width * ((cell.height + 7) / 8)) > FontTools::MaxGlyphBytes)
+	{
+		fprintf(stderr, "bdf2font: glyphs larger than %zu bytes can't be run length encoded\n", FontTools::MaxGlyphBytes);
+		return 1;
+	}
+
+	const std::vector<uint8_t> raw = rawFont(bdf, options.first, options.last, cell);
+	const std::vector<uint8_t> font = convert(raw, cell.height, options.flags, options.spacing, options.charset);
+	const size_t entry = FontTools::glyphEntrySize(options.flags);
+	if (entry != 0 && font.size() > 0xFFFF)
+	{
+		fprintf(stderr, "bdf2font: glyph data over 64 KiB, the 16 bit glyph table can't address it\n");
+		return 1;
+	}
+	if (options.report) printReport(raw, cell.height, options);
+
+	FILE* out = stdout;
+	if (!options.output.empty() && (out = std::fopen(options.output.c_str(), "w")) == nullptr)
+	{
+		fprintf(stderr, "bdf2font: cannot write %s\n", options.output.c_str());
+		return 1;
+	}
+	writeHeader(out, font, options);
+	if (out != stdout) std::fclose(out);
+	return 0;
+}